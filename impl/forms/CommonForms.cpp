@@ -10,10 +10,7 @@ namespace mavis
      */
     const char* Form_AMO::name{"AMO"};
 
-    const FieldsType Form_AMO::fields{
-        Field("func5", 27, 5), Field("aq", 26, 1),  Field("wd", 26, 1),   Field("rl", 25, 1),
-        Field("vm", 25, 1),    Field("rs2", 20, 5), Field("rs1", 15, 5),  Field("func3", 12, 3),
-        Field("width", 12, 3), Field("rd", 7, 5),   Field("opcode", 0, 7)};
+    const FieldsType Form_AMO::fields{makeFields(Form_AMO::field_layout)};
 
     const std::map<std::string, const Field &> Form_AMO::fmap{
         {"func5",  Form_AMO::fields[Form_AMO::idType::FUNC5] },
@@ -54,9 +51,7 @@ namespace mavis
      */
     const char* Form_B::name{"B"};
 
-    const FieldsType Form_B::fields{Field("imm7", 25, 7), Field("rs2", 20, 5),
-                                    Field("rs1", 15, 5),  Field("func3", 12, 3),
-                                    Field("imm5", 7, 5),  Field("opcode", 0, 7)};
+    const FieldsType Form_B::fields{makeFields(Form_B::field_layout)};
 
     const std::map<std::string, const Field &> Form_B::fmap{
         {"imm7",   Form_B::fields[Form_B::idType::IMM7]  },
@@ -86,9 +81,7 @@ namespace mavis
      */
     const char* Form_CSR::name{"CSR"};
 
-    const FieldsType Form_CSR::fields{Field("csr", 20, 12), Field("rs1", 15, 5),
-                                      Field("func3", 12, 3), Field("rd", 7, 5),
-                                      Field("opcode", 0, 7)};
+    const FieldsType Form_CSR::fields{makeFields(Form_CSR::field_layout)};
 
     const std::map<std::string, const Field &> Form_CSR::fmap{
         {"csr",    Form_CSR::fields[Form_CSR::idType::CSR]   },
@@ -116,9 +109,7 @@ namespace mavis
      */
     const char* Form_CSRI::name{"CSRI"};
 
-    const FieldsType Form_CSRI::fields{Field("csr", 20, 12), Field("uimm", 15, 5),
-                                       Field("func3", 12, 3), Field("rd", 7, 5),
-                                       Field("opcode", 0, 7)};
+    const FieldsType Form_CSRI::fields{makeFields(Form_CSRI::field_layout)};
 
     const std::map<std::string, const Field &> Form_CSRI::fmap{
         {"csr",    Form_CSRI::fields[Form_CSRI::idType::CSR]   },
@@ -146,9 +137,7 @@ namespace mavis
      */
     const char* Form_FENCE::name{"FENCE"};
 
-    const FieldsType Form_FENCE::fields{
-        Field("fm", 28, 4),    Field("pred", 24, 4), Field("succ", 20, 4), Field("rs1", 15, 5),
-        Field("func3", 12, 3), Field("rd", 7, 5),    Field("opcode", 0, 7)};
+    const FieldsType Form_FENCE::fields{makeFields(Form_FENCE::field_layout)};
 
     const std::map<std::string, const Field &> Form_FENCE::fmap{
         {"fm",     Form_FENCE::fields[Form_FENCE::idType::FM]    },
@@ -180,9 +169,7 @@ namespace mavis
      */
     const char* Form_I::name{"I"};
 
-    const FieldsType Form_I::fields{Field("imm", 20, 12), Field("rs1", 15, 5),
-                                    Field("func3", 12, 3), Field("rd", 7, 5),
-                                    Field("opcode", 0, 7)};
+    const FieldsType Form_I::fields{makeFields(Form_I::field_layout)};
 
     const std::map<std::string, const Field &> Form_I::fmap{
         {"imm",    Form_I::fields[Form_I::idType::IMM]   },
@@ -210,9 +197,7 @@ namespace mavis
      */
     const char* Form_ISH::name{"ISH"};
 
-    const FieldsType Form_ISH::fields{
-        Field("func2", 30, 2), Field("func4", 26, 4), Field("shamt", 20, 6), Field("rs1", 15, 5),
-        Field("func3", 12, 3), Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_ISH::fields{makeFields(Form_ISH::field_layout)};
 
     const std::map<std::string, const Field &> Form_ISH::fmap{
         {"func2",  Form_ISH::fields[Form_ISH::idType::FUNC2] },
@@ -245,9 +230,7 @@ namespace mavis
      */
     const char* Form_ISHW::name{"ISHW"};
 
-    const FieldsType Form_ISHW::fields{
-        Field("func2", 30, 2), Field("func4", 26, 4), Field("func1", 25, 1), Field("shamtw", 20, 5),
-        Field("rs1", 15, 5),   Field("func3", 12, 3), Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_ISHW::fields{makeFields(Form_ISHW::field_layout)};
 
     const std::map<std::string, const Field &> Form_ISHW::fmap{
         {"func2",  Form_ISHW::fields[Form_ISHW::idType::FUNC2] },
@@ -283,8 +266,7 @@ namespace mavis
      */
     const char* Form_J::name{"J"};
 
-    const FieldsType Form_J::fields{Field("imm20", 12, 20), Field("rd", 7, 5),
-                                    Field("opcode", 0, 7)};
+    const FieldsType Form_J::fields{makeFields(Form_J::field_layout)};
 
     const std::map<std::string, const Field &> Form_J::fmap{
         {"imm20",  Form_J::fields[Form_J::idType::IMM20] },
@@ -307,9 +289,7 @@ namespace mavis
      */
     const char* Form_R::name{"R"};
 
-    const FieldsType Form_R::fields{
-        Field("func2", 30, 2), Field("func4", 26, 4), Field("func1", 25, 1), Field("rs2", 20, 5),
-        Field("rs1", 15, 5),   Field("func3", 12, 3), Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_R::fields{makeFields(Form_R::field_layout)};
 
     const std::map<std::string, const Field &> Form_R::fmap{
         {"func2",  Form_R::fields[Form_R::idType::FUNC2] },
@@ -345,9 +325,7 @@ namespace mavis
      */
     const char* Form_Rfloat::name{"Rfloat"};
 
-    const FieldsType Form_Rfloat::fields{Field("func7", 25, 7), Field("rs2", 20, 5),
-                                         Field("rs1", 15, 5),   Field("rm", 12, 3),
-                                         Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_Rfloat::fields{makeFields(Form_Rfloat::field_layout)};
 
     const std::map<std::string, const Field &> Form_Rfloat::fmap{
         {"func7",  Form_Rfloat::fields[Form_Rfloat::idType::FUNC7] },
@@ -377,9 +355,7 @@ namespace mavis
      */
     const char* Form_R4::name{"R4"};
 
-    const FieldsType Form_R4::fields{
-        Field("rs3", 27, 5), Field("func2", 25, 2), Field("rs2", 20, 5),  Field("rs1", 15, 5),
-        Field("rm", 12, 3),  Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_R4::fields{makeFields(Form_R4::field_layout)};
 
     const std::map<std::string, const Field &> Form_R4::fmap{
         {"rs3",    Form_R4::fields[Form_R4::idType::RS3]   },
@@ -411,9 +387,7 @@ namespace mavis
      */
     const char* Form_S::name{"S"};
 
-    const FieldsType Form_S::fields{Field("imm7", 25, 7), Field("rs2", 20, 5),
-                                    Field("rs1", 15, 5),  Field("func3", 12, 3),
-                                    Field("imm5", 7, 5),  Field("opcode", 0, 7)};
+    const FieldsType Form_S::fields{makeFields(Form_S::field_layout)};
 
     const std::map<std::string, const Field &> Form_S::fmap{
         {"imm7",   Form_S::fields[Form_S::idType::IMM7]  },
@@ -443,8 +417,7 @@ namespace mavis
      */
     const char* Form_U::name{"U"};
 
-    const FieldsType Form_U::fields{Field("imm20", 12, 20), Field("rd", 7, 5),
-                                    Field("opcode", 0, 7)};
+    const FieldsType Form_U::fields{makeFields(Form_U::field_layout)};
 
     const std::map<std::string, const Field &> Form_U::fmap{
         {"imm20",  Form_U::fields[Form_U::idType::IMM20] },
@@ -467,10 +440,7 @@ namespace mavis
      */
     const char* Form_AES64KSI::name{"AES64KSI"};
 
-    const FieldsType Form_AES64KSI::fields{
-        Field("func2", 30, 2),  Field("func4", 26, 4), Field("func1a", 25, 1),
-        Field("func1b", 24, 1), Field("rnum", 20, 4),  Field("rs1", 15, 5),
-        Field("func3", 12, 3),  Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_AES64KSI::fields{makeFields(Form_AES64KSI::field_layout)};
 
     const std::map<std::string, const Field &> Form_AES64KSI::fmap{
         {"func2",  Form_AES64KSI::fields[Form_AES64KSI::idType::FUNC2] },
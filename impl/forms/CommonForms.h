@@ -31,6 +31,21 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func5",  27, 5},
+            {"aq",     26, 1},
+            {"wd",     26, 1},
+            {"rl",     25, 1},
+            {"vm",     25, 1},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"width",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -56,6 +71,16 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"imm7",   25, 7},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"imm5",    7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -80,6 +105,15 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"csr",    20, 12},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -104,6 +138,15 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"csr",    20, 12},
+            {"uimm",   15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -131,6 +174,16 @@ namespace mavis
 
         static const char* name;
 
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"fm",     28, 4},
+            {"pred",   24, 4},
+            {"succ",   20, 4},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
 
         static const std::map<std::string, const Field &> fmap;
@@ -159,6 +212,15 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"imm",    20, 12},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -185,6 +247,17 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func2",  30, 2},
+            {"func4",  26, 4},
+            {"shamt",  20, 6},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -212,6 +285,18 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func2",  30, 2},
+            {"func4",  26, 4},
+            {"func1",  25, 1},
+            {"shamtw", 20, 5},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -234,6 +319,13 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"imm20",  12, 20},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -261,6 +353,18 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func2",  30, 2},
+            {"func4",  26, 4},
+            {"func1",  25, 1},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -286,6 +390,16 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func7",  25, 7},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"rm",     12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -312,6 +426,17 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"rs3",    27, 5},
+            {"func2",  25, 2},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"rm",     12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -337,6 +462,16 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"imm7",   25, 7},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"imm5",    7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -359,6 +494,13 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"imm20",  12, 20},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -385,6 +527,19 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func2",  30, 2},
+            {"func4",  26, 4},
+            {"func1a", 25, 1},
+            {"func1b", 24, 1},
+            {"rnum",   20, 4},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -8,9 +8,7 @@ namespace mavis
      */
     const char* Form_C0::name{"C0"};
 
-    const FieldsType Form_C0::fields{
-        Field("func3", 13, 3), Field("imm3", 10, 3), Field("rs1", 7, 3),   Field("func2A", 6, 1),
-        Field("imm2", 5, 2),   Field("rd", 2, 3),    Field("opcode", 0, 2)};
+    const FieldsType Form_C0::fields{makeFields(Form_C0::field_layout)};
 
     const std::map<std::string, const Field &> Form_C0::fmap{
         {"func3",  Form_C0::fields[Form_C0::idType::FUNC3] },
@@ -43,11 +41,7 @@ namespace mavis
      */
     const char* Form_C1::name{"C1"};
 
-    const FieldsType Form_C1::fields{
-        Field("func3", 13, 3), Field("func1", 12, 1), Field("func2", 10, 2),
-        Field("rs1", 7, 3), // RD and RS1 are aliases for the same field
-        Field("rd", 7, 3),  // RD and RS1 are aliases for the same field
-        Field("func2b", 5, 2), Field("rs2", 2, 3), Field("imm5", 2, 5), Field("opcode", 0, 2)};
+    const FieldsType Form_C1::fields{makeFields(Form_C1::field_layout)};
 
     const std::map<std::string, const Field &> Form_C1::fmap{
         {"func3",  Form_C1::fields[Form_C1::idType::FUNC3] },
@@ -86,12 +80,7 @@ namespace mavis
      */
     const char* Form_C2::name{"C2"};
 
-    const FieldsType Form_C2::fields{Field("func3", 13, 3),  Field("func1", 12, 1),
-                                     Field("shamt1", 12, 1),                     // Alias for FUNC1
-                                     Field("rd", 7, 5),      Field("rs1", 7, 5), // Alias for RD
-                                     Field("rs", 2, 5),      Field("rs2", 2, 5), // Alias for RS
-                                     Field("shamt5", 2, 5),                      // Alias for RS
-                                     Field("opcode", 0, 2)};
+    const FieldsType Form_C2::fields{makeFields(Form_C2::field_layout)};
 
     const std::map<std::string, const Field &> Form_C2::fmap{
         {"func3",  Form_C2::fields[Form_C2::idType::FUNC3] },
@@ -128,8 +117,7 @@ namespace mavis
      */
     const char* Form_C2_sp_store::name{"C2_sp_store"};
 
-    const FieldsType Form_C2_sp_store::fields{Field("func3", 13, 3), Field("imm", 7, 6),
-                                              Field("rs2", 2, 5), Field("opcode", 0, 2)};
+    const FieldsType Form_C2_sp_store::fields{makeFields(Form_C2_sp_store::field_layout)};
 
     const std::map<std::string, const Field &> Form_C2_sp_store::fmap{
         {"func3",  Form_C2_sp_store::fields[Form_C2_sp_store::idType::FUNC3] },
@@ -156,9 +144,7 @@ namespace mavis
      */
     const char* Form_CA::name{"CA"};
 
-    const FieldsType Form_CA::fields{Field("func6", 10, 6), Field("rs1", 7, 3),
-                                     Field("rd", 7, 3),     Field("func2", 5, 2),
-                                     Field("rs2", 2, 3),    Field("opcode", 0, 2)};
+    const FieldsType Form_CA::fields{makeFields(Form_CA::field_layout)};
 
     const std::map<std::string, const Field &> Form_CA::fmap{
         {"func6",  Form_CA::fields[Form_CA::idType::FUNC6] },
@@ -189,9 +175,7 @@ namespace mavis
      */
     const char* Form_CB::name{"CB"};
 
-    const FieldsType Form_CB::fields{Field("func3", 13, 3), Field("imm3", 10, 3),
-                                     Field("rs1", 7, 3), Field("imm5", 2, 5),
-                                     Field("opcode", 0, 2)};
+    const FieldsType Form_CB::fields{makeFields(Form_CB::field_layout)};
 
     const std::map<std::string, const Field &> Form_CB::fmap{
         {"func3",  Form_CB::fields[Form_CB::idType::FUNC3] },
@@ -219,9 +203,7 @@ namespace mavis
      */
     const char* Form_CI::name{"CI"};
 
-    const FieldsType Form_CI::fields{Field("func3", 13, 3), Field("imm1", 12, 1),
-                                     Field("rs1", 7, 5),    Field("rd", 7, 5),
-                                     Field("imm5", 2, 5),   Field("opcode", 0, 2)};
+    const FieldsType Form_CI::fields{makeFields(Form_CI::field_layout)};
 
     const std::map<std::string, const Field &> Form_CI::fmap{
         {"func3",  Form_CI::fields[Form_CI::idType::FUNC3] },
@@ -251,9 +233,7 @@ namespace mavis
      */
     const char* Form_CI_rD_only::name{"CI_rD_only"};
 
-    const FieldsType Form_CI_rD_only::fields{Field("func3", 13, 3), Field("imm1", 12, 1),
-                                             Field("rd", 7, 5), Field("imm5", 2, 5),
-                                             Field("opcode", 0, 2)};
+    const FieldsType Form_CI_rD_only::fields{makeFields(Form_CI_rD_only::field_layout)};
 
     const std::map<std::string, const Field &> Form_CI_rD_only::fmap{
         {"func3",  Form_CI_rD_only::fields[Form_CI_rD_only::idType::FUNC3] },
@@ -282,8 +262,7 @@ namespace mavis
      */
     const char* Form_CIW::name{"CIW"};
 
-    const FieldsType Form_CIW::fields{Field("func3", 13, 3), Field("imm8", 5, 8), Field("rd", 2, 3),
-                                      Field("opcode", 0, 2)};
+    const FieldsType Form_CIW::fields{makeFields(Form_CIW::field_layout)};
 
     const std::map<std::string, const Field &> Form_CIW::fmap{
         {"func3",  Form_CIW::fields[Form_CIW::idType::FUNC3] },
@@ -309,9 +288,7 @@ namespace mavis
      */
     const char* Form_CIX::name{"CIX"};
 
-    const FieldsType Form_CIX::fields{
-        Field("func3", 13, 3), Field("shamt1", 12, 1), Field("func2", 10, 2), Field("rs1", 7, 3),
-        Field("rd", 7, 3),     Field("shamt5", 2, 5),  Field("opcode", 0, 2)};
+    const FieldsType Form_CIX::fields{makeFields(Form_CIX::field_layout)};
 
     const std::map<std::string, const Field &> Form_CIX::fmap{
         {"func3",  Form_CIX::fields[Form_CIX::idType::FUNC3] },
@@ -344,8 +321,7 @@ namespace mavis
      */
     const char* Form_CJ::name{"CJ"};
 
-    const FieldsType Form_CJ::fields{Field("func3", 13, 3), Field("imm11", 2, 11),
-                                     Field("opcode", 0, 2)};
+    const FieldsType Form_CJ::fields{makeFields(Form_CJ::field_layout)};
 
     const std::map<std::string, const Field &> Form_CJ::fmap{
         {"func3",  Form_CJ::fields[Form_CJ::idType::FUNC3] },
@@ -369,8 +345,7 @@ namespace mavis
      */
     const char* Form_CJR::name{"CJR"};
 
-    const FieldsType Form_CJR::fields{Field("func4", 12, 4), Field("rs1", 7, 5), Field("rs2", 2, 5),
-                                      Field("opcode", 0, 2)};
+    const FieldsType Form_CJR::fields{makeFields(Form_CJR::field_layout)};
 
     const std::map<std::string, const Field &> Form_CJR::fmap{
         {"func4",  Form_CJR::fields[Form_CJR::idType::FUNC4] },
@@ -396,11 +371,7 @@ namespace mavis
      */
     const char* Form_CMPP::name{"CMPP"};
 
-    const FieldsType Form_CMPP::fields{
-        Field("func3", 13, 3),  Field("func1", 12, 1), // func6 is split into func3, func1, and
-                                                       // func2A
-        Field("func2A", 10, 2), Field("func2", 8, 2),  Field("urlist", 4, 4),
-        Field("spimm", 2, 2),   Field("opcode", 0, 2)};
+    const FieldsType Form_CMPP::fields{makeFields(Form_CMPP::field_layout)};
 
     const std::map<std::string, const Field &> Form_CMPP::fmap{
         {"func3",  Form_CMPP::fields[Form_CMPP::idType::FUNC3] },
@@ -434,10 +405,7 @@ namespace mavis
      */
     const char* Form_CMJT::name{"CMJT"};
 
-    const FieldsType Form_CMJT::fields{
-        Field("func3", 13, 3),
-        Field("func1", 12, 1), // func6 is split into func3, func1, and func2A
-        Field("func2A", 10, 2), Field("index", 2, 8), Field("opcode", 0, 2)};
+    const FieldsType Form_CMJT::fields{makeFields(Form_CMJT::field_layout)};
 
     const std::map<std::string, const Field &> Form_CMJT::fmap{
         {"func3",  Form_CMJT::fields[Form_CMJT::idType::FUNC3] },
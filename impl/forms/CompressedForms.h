@@ -26,6 +26,17 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"imm3",   10, 3},
+            {"rs1",     7, 3},
+            {"func2A",  6, 1},
+            {"imm2",    5, 2},
+            {"rd",      2, 3},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -54,6 +65,19 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"func1",  12, 1},
+            {"func2",  10, 2},
+            {"rs1",     7, 3}, // RD and RS1 are aliases for the same field
+            {"rd",      7, 3}, // RD and RS1 are aliases for the same field
+            {"func2b",  5, 2},
+            {"rs2",     2, 3},
+            {"imm5",    2, 5},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -82,6 +106,19 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"func1",  12, 1},
+            {"shamt1", 12, 1}, // Alias for FUNC1
+            {"rd",      7, 5},
+            {"rs1",     7, 5},
+            {"rs",      2, 5},
+            {"rs2",     2, 5},
+            {"shamt5",  2, 5}, // Alias for RS
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -105,6 +142,14 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"imm",     7, 6},
+            {"rs2",     2, 5},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -130,6 +175,16 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func6",  10, 6},
+            {"rs1",     7, 3},
+            {"rd",      7, 3},
+            {"func2",   5, 2},
+            {"rs2",     2, 3},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -154,6 +209,15 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"imm3",   10, 3},
+            {"rs1",     7, 3},
+            {"imm5",    2, 5},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -179,6 +243,16 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"imm1",   12, 1},
+            {"rs1",     7, 5},
+            {"rd",      7, 5},
+            {"imm5",    2, 5},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -203,6 +277,15 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"imm1",   12, 1},
+            {"rd",      7, 5},
+            {"imm5",    2, 5},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -226,6 +309,14 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"imm8",    5, 8},
+            {"rd",      2, 3},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -252,6 +343,17 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"shamt1", 12, 1},
+            {"func2",  10, 2},
+            {"rs1",     7, 3},
+            {"rd",      7, 3},
+            {"shamt5",  2, 5},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -274,6 +376,13 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"imm11",   2, 11},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -297,6 +406,14 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func4",  12, 4},
+            {"rs1",     7, 5},
+            {"rs2",     2, 5},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -320,6 +437,17 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"func1",  12, 1},
+            {"func2A", 10, 2},
+            {"func2",   8, 2},
+            {"urlist",  4, 4},
+            {"spimm",   2, 2},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -341,6 +469,15 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func3",  13, 3},
+            {"func1",  12, 1}, // func6 is split into func3, func1, and func2A
+            {"func2A", 10, 2},
+            {"index",   2, 8},
+            {"opcode",  0, 2},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -109,6 +109,13 @@ namespace mavis
             return olist;
         }
 
+        // The destinations differ from Form_I, so don't inherit its single pass extraction
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            ExtractorIF::extractAll(icode, meta, fields);
+        }
+
       private:
         Extractor(const uint64_t ffmask, const uint64_t fset) : Extractor<Form_I_load>(ffmask, fset)
         {
@@ -344,6 +351,13 @@ namespace mavis
             return olist;
         }
 
+        // The destinations differ from Form_C0, so don't inherit its single pass extraction
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            ExtractorIF::extractAll(icode, meta, fields);
+        }
+
       private:
         Extractor(const uint64_t ffmask, const uint64_t fset) :
             Extractor<Form_C0_load_double>(ffmask, fset)
@@ -413,6 +427,13 @@ namespace mavis
             }
             return olist;
         }
+
+        // The sources differ from Form_S, so don't inherit its single pass extraction
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            ExtractorIF::extractAll(icode, meta, fields);
+        }
     };
 
     /**
@@ -502,6 +523,19 @@ namespace mavis
             return {};
         }
 
+        // Also used by the byte/half/word/double derivatives, hence the virtual calls for the
+        // immediate
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedCompressedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_C0::idType::RS1, InstMetaData::OperandFieldID::RS1},
+                 {Form_C0::idType::RD, InstMetaData::OperandFieldID::RS2, true}},
+                fields.sources, fields.source_opinfo);
+            extractImmediate_(icode, fields);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
 
         // overloads are considered
@@ -730,6 +764,13 @@ namespace mavis
             return olist;
         }
 
+        // The sources differ from Form_C0_store, so don't inherit its single pass extraction
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            ExtractorIF::extractAll(icode, meta, fields);
+        }
+
       private:
         Extractor(const uint64_t ffmask, const uint64_t fset) :
             Extractor<Form_C0_store_double>(ffmask, fset)
@@ -1222,6 +1263,16 @@ namespace mavis
             return Swizzler::extract(imm, R{3}, R{2}, R{6, 9}, R{4, 5});
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            Extractor<Form_CIW>::extractAll(icode, meta, fields);
+            fields.sources = 1ull << REGISTER_SP;
+            fields.source_opinfo.addElement(
+                InstMetaData::OperandFieldID::RS1,
+                meta->getOperandType(InstMetaData::OperandFieldID::RD), REGISTER_SP, false);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
 
         // overloads are considered
@@ -1334,6 +1385,19 @@ namespace mavis
             return olist;
         }
 
+        // The destination differs from Form_CJ (the immediate doesn't)
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            fields.dests = 1ull << REGISTER_LINK;
+            fields.dest_opinfo.addElement(
+                InstMetaData::OperandFieldID::RD,
+                meta->getOperandType(InstMetaData::OperandFieldID::RS1), REGISTER_LINK, false);
+            fields.immediate_type = ImmediateType::SIGNED;
+            fields.immediate = getImmediate(icode);
+            fields.signed_offset = signExtend_(fields.immediate, 11);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
 
         // overloads are considered
@@ -1429,6 +1493,20 @@ namespace mavis
             return olist;
         }
 
+        // The destination differs from Form_CJR (the source doesn't)
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_CJR::idType::RS1, InstMetaData::OperandFieldID::RS1}},
+                                     fields.sources, fields.source_opinfo);
+            fields.dests = 1ull << REGISTER_LINK;
+            fields.dest_opinfo.addElement(
+                InstMetaData::OperandFieldID::RD,
+                meta->getOperandType(InstMetaData::OperandFieldID::RS1), REGISTER_LINK, false);
+            fields.immediate_type = Form_CJR::immediate_type;
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
 
         // overloads are considered
@@ -1528,6 +1606,20 @@ namespace mavis
             return olist;
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_C2::idType::RS1, InstMetaData::OperandFieldID::RS1},
+                                      {Form_C2::idType::RS2, InstMetaData::OperandFieldID::RS2}},
+                                     fields.sources, fields.source_opinfo);
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_C2::idType::RD, InstMetaData::OperandFieldID::RD}},
+                                     fields.dests, fields.dest_opinfo);
+            fields.immediate_type = Form_C2::immediate_type;
+            fields.is_hint = (fields.dests & (1ull << REGISTER_X0)) != 0;
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
 
         // overloads are considered
@@ -1626,6 +1718,24 @@ namespace mavis
             return olist;
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            // Implicit x0 source, with the type of RS1
+            fields.sources = 1ull << REGISTER_X0;
+            fields.source_opinfo.addElement(
+                InstMetaData::OperandFieldID::RS1,
+                meta->getOperandType(InstMetaData::OperandFieldID::RS1), REGISTER_X0, false);
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_C2::idType::RS, InstMetaData::OperandFieldID::RS2}},
+                                     fields.sources, fields.source_opinfo);
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_C2::idType::RD, InstMetaData::OperandFieldID::RD}},
+                                     fields.dests, fields.dest_opinfo);
+            fields.immediate_type = Form_C2::immediate_type;
+            fields.is_hint = (fields.dests & (1ull << REGISTER_X0)) != 0;
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
 
         // overloads are considered
@@ -2218,6 +2328,13 @@ namespace mavis
             return olist;
         }
 
+        // The sources differ from Form_C2_sp_store, so don't inherit its single pass extraction
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            ExtractorIF::extractAll(icode, meta, fields);
+        }
+
       private:
         Extractor(const uint64_t ffmask, const uint64_t fset) :
             Extractor<Form_C2_sp_store_double>(ffmask, fset)
@@ -2392,6 +2509,13 @@ namespace mavis
      */
     template <> class Extractor<Form_CMMV_mva01s> : public Extractor<Form_CA>
     {
+        // The registers differ from Form_CA, so don't inherit its single pass extraction
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            ExtractorIF::extractAll(icode, meta, fields);
+        }
+
       protected:
         static constexpr std::pair<uint64_t, uint64_t> decodeRegs_(const Opcode icode)
         {
@@ -258,6 +258,18 @@ namespace mavis
             return signExtend_(getImmediate(icode), 12);
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_B::idType::RS1, InstMetaData::OperandFieldID::RS1},
+                                      {Form_B::idType::RS2, InstMetaData::OperandFieldID::RS2}},
+                                     fields.sources, fields.source_opinfo);
+            fields.immediate_type = ImmediateType::SIGNED;
+            fields.immediate = Extractor<Form_B>::getImmediate(icode);
+            fields.signed_offset = signExtend_(fields.immediate, 12);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -381,6 +393,21 @@ namespace mavis
             return olist;
         }
 
+        // Also used by the Form_C0_load derivatives, hence the virtual calls for the immediate
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedCompressedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_C0::idType::RS1, InstMetaData::OperandFieldID::RS1}}, fields.sources,
+                fields.source_opinfo);
+            extractUnmaskedCompressedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_C0::idType::RD, InstMetaData::OperandFieldID::RD}}, fields.dests,
+                fields.dest_opinfo);
+            extractImmediate_(icode, fields);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -617,6 +644,21 @@ namespace mavis
             return olist;
         }
 
+        // Also used by the word/double derivatives, hence the virtual calls for the immediate
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            fields.sources = 1ull << REGISTER_SP;
+            fields.source_opinfo.addElement(
+                InstMetaData::OperandFieldID::RS1,
+                meta->getOperandType(InstMetaData::OperandFieldID::RS1), REGISTER_SP, false);
+            extractUnmaskedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_C2_sp_store::idType::RS2, InstMetaData::OperandFieldID::RS2, true}},
+                fields.sources, fields.source_opinfo);
+            extractImmediate_(icode, fields);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -756,6 +798,21 @@ namespace mavis
             return olist;
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedCompressedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_CA::idType::RS1, InstMetaData::OperandFieldID::RS1},
+                 {Form_CA::idType::RS2, InstMetaData::OperandFieldID::RS2}},
+                fields.sources, fields.source_opinfo);
+            extractUnmaskedCompressedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_CA::idType::RD, InstMetaData::OperandFieldID::RD}}, fields.dests,
+                fields.dest_opinfo);
+            fields.immediate_type = Form_CA::immediate_type;
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -867,6 +924,22 @@ namespace mavis
             return signExtend_(getImmediate(icode), 8);
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedCompressedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_CB::idType::RS1, InstMetaData::OperandFieldID::RS1}}, fields.sources,
+                fields.source_opinfo);
+            fields.sources |= 1ull << REGISTER_X0;
+            fields.source_opinfo.addElement(
+                InstMetaData::OperandFieldID::RS2,
+                meta->getOperandType(InstMetaData::OperandFieldID::RS1), REGISTER_X0, false);
+            fields.immediate_type = ImmediateType::SIGNED;
+            fields.immediate = getImmediate(icode);
+            fields.signed_offset = signExtend_(fields.immediate, 8);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -999,6 +1072,20 @@ namespace mavis
             return signExtend_(getImmediate(icode), 5);
         }
 
+        // Also used by the Form_CI_addi/addiw/sp derivatives, hence the virtual calls for the
+        // immediate and hint
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_CI::idType::RS1, InstMetaData::OperandFieldID::RS1}},
+                                     fields.sources, fields.source_opinfo);
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_CI::idType::RD, InstMetaData::OperandFieldID::RD}},
+                                     fields.dests, fields.dest_opinfo);
+            extractImmediate_(icode, fields);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -1246,6 +1333,17 @@ namespace mavis
             return olist;
         }
 
+        // Also used by Form_CIW_sp, hence the virtual calls for the immediate
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedCompressedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_CIW::idType::RD, InstMetaData::OperandFieldID::RD}}, fields.dests,
+                fields.dest_opinfo);
+            extractImmediate_(icode, fields);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -1496,6 +1594,18 @@ namespace mavis
             return signExtend_(getImmediate(icode), 11);
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            // Implicit x0 dest, with "LONG" type
+            fields.dests = 1ull << REGISTER_X0;
+            fields.dest_opinfo.addElement(InstMetaData::OperandFieldID::RD,
+                                          InstMetaData::OperandTypes::LONG, REGISTER_X0, false);
+            fields.immediate_type = ImmediateType::SIGNED;
+            fields.immediate = getImmediate(icode);
+            fields.signed_offset = signExtend_(fields.immediate, 11);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -1607,6 +1717,19 @@ namespace mavis
             return olist;
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_CJR::idType::RS1, InstMetaData::OperandFieldID::RS1}},
+                                     fields.sources, fields.source_opinfo);
+            // Implicit x0 dest, with "LONG" type
+            fields.dests = 1ull << REGISTER_X0;
+            fields.dest_opinfo.addElement(InstMetaData::OperandFieldID::RD,
+                                          InstMetaData::OperandTypes::LONG, REGISTER_X0, false);
+            fields.immediate_type = Form_CJR::immediate_type;
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -2458,6 +2581,23 @@ namespace mavis
             return signExtend_(getImmediate(icode), 11);
         }
 
+        // Also used by the Form_I_mv and Form_I_load derivatives, hence the virtual calls for
+        // the immediate type and hint
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_I::idType::RS1, InstMetaData::OperandFieldID::RS1}},
+                                     fields.sources, fields.source_opinfo);
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_I::idType::RD, InstMetaData::OperandFieldID::RD}},
+                                     fields.dests, fields.dest_opinfo);
+            fields.immediate_type = getImmediateType();
+            fields.immediate = extract_(Form_I::idType::IMM, icode);
+            fields.signed_offset = signExtend_(fields.immediate, 11);
+            fields.is_hint = isHint(icode);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -2822,6 +2962,17 @@ namespace mavis
             return signExtend_(getImmediate(icode), 20);
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_J::idType::RD, InstMetaData::OperandFieldID::RD}},
+                                     fields.dests, fields.dest_opinfo);
+            fields.immediate_type = ImmediateType::SIGNED;
+            fields.immediate = Extractor<Form_J>::getImmediate(icode);
+            fields.signed_offset = signExtend_(fields.immediate, 20);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -2947,6 +3098,19 @@ namespace mavis
             return olist;
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_R::idType::RS1, InstMetaData::OperandFieldID::RS1},
+                                      {Form_R::idType::RS2, InstMetaData::OperandFieldID::RS2}},
+                                     fields.sources, fields.source_opinfo);
+            extractUnmaskedOperands_(icode, meta, fixed_field_mask_,
+                                     {{Form_R::idType::RD, InstMetaData::OperandFieldID::RD}},
+                                     fields.dests, fields.dest_opinfo);
+            fields.immediate_type = Form_R::immediate_type;
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -3368,6 +3532,19 @@ namespace mavis
             return olist;
         }
 
+        void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                        ExtractedFields & fields) const override
+        {
+            extractUnmaskedOperands_(
+                icode, meta, fixed_field_mask_,
+                {{Form_S::idType::RS1, InstMetaData::OperandFieldID::RS1},
+                 {Form_S::idType::RS2, InstMetaData::OperandFieldID::RS2, true}},
+                fields.sources, fields.source_opinfo);
+            fields.immediate_type = ImmediateType::SIGNED;
+            fields.immediate = Extractor<Form_S>::getImmediate(icode);
+            fields.signed_offset = signExtend_(fields.immediate, 11);
+        }
+
         using ExtractorIF::dasmString; // tell the compiler all dasmString
                                        // overloads are considered
 
@@ -8,11 +8,7 @@ namespace mavis
      */
     const char* Form_V::name{"V"};
 
-    const FieldsType Form_V::fields{
-        Field("func1a", 31, 1), Field("func1b", 30, 1), Field("func3a", 27, 3),
-        Field("func1c", 26, 1), Field("vm", 25, 1),     Field("rs2", 20, 5),
-        Field("rs1", 15, 5),    Field("simm5", 15, 5),  Field("func3b", 12, 3),
-        Field("rd", 7, 5),      Field("opcode", 0, 7)};
+    const FieldsType Form_V::fields{makeFields(Form_V::field_layout)};
 
     const std::map<std::string, const Field &> Form_V::fmap{
         {"func1a", Form_V::fields[Form_V::idType::FUNC1A]},
@@ -54,10 +50,7 @@ namespace mavis
      */
     const char* Form_VF_mem::name{"VF_mem"};
 
-    const FieldsType Form_VF_mem::fields{
-        Field("nf", 29, 3),  Field("mewop", 26, 3), Field("vm", 25, 1),
-        Field("rs2", 20, 5), Field("rs1", 15, 5),   Field("width", 12, 3),
-        Field("rd", 7, 5),   Field("rs3", 7, 5),    Field("opcode", 0, 7)};
+    const FieldsType Form_VF_mem::fields{makeFields(Form_VF_mem::field_layout)};
 
     const std::map<std::string, const Field &> Form_VF_mem::fmap{
         {"nf",     Form_VF_mem::fields[Form_VF_mem::idType::NF]    },
@@ -94,9 +87,7 @@ namespace mavis
      */
     const char* Form_V_vsetvli::name{"V_vsetvli"};
 
-    const FieldsType Form_V_vsetvli::fields{Field("func1", 31, 1), Field("imm11", 20, 11),
-                                            Field("rs1", 15, 5),   Field("func3", 12, 3),
-                                            Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_V_vsetvli::fields{makeFields(Form_V_vsetvli::field_layout)};
 
     const std::map<std::string, const Field &> Form_V_vsetvli::fmap{
         {"func1",  Form_V_vsetvli::fields[Form_V_vsetvli::idType::FUNC1] },
@@ -128,9 +119,7 @@ namespace mavis
      */
     const char* Form_V_vsetivli::name{"V_vsetivli"};
 
-    const FieldsType Form_V_vsetivli::fields{Field("func2", 30, 2), Field("imm10", 20, 10),
-                                             Field("avl", 15, 5),   Field("func3", 12, 3),
-                                             Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_V_vsetivli::fields{makeFields(Form_V_vsetivli::field_layout)};
 
     const std::map<std::string, const Field &> Form_V_vsetivli::fmap{
         {"func2",  Form_V_vsetivli::fields[Form_V_vsetivli::idType::FUNC2] },
@@ -162,9 +151,7 @@ namespace mavis
      */
     const char* Form_V_vsetvl::name{"V_vsetvl"};
 
-    const FieldsType Form_V_vsetvl::fields{Field("func7", 25, 7), Field("rs2", 20, 5),
-                                           Field("rs1", 15, 5),   Field("func3", 12, 3),
-                                           Field("rd", 7, 5),     Field("opcode", 0, 7)};
+    const FieldsType Form_V_vsetvl::fields{makeFields(Form_V_vsetvl::field_layout)};
 
     const std::map<std::string, const Field &> Form_V_vsetvl::fmap{
         {"func7",  Form_V_vsetvl::fields[Form_V_vsetvl::idType::FUNC7] },
@@ -195,9 +182,7 @@ namespace mavis
      */
     const char* Form_V_uimm6::name{"V_uimm6"};
 
-    const FieldsType Form_V_uimm6::fields{
-        Field("func5", 27, 5), Field("i5", 26, 1),    Field("vm", 25, 1), Field("rs2", 20, 5),
-        Field("uimm5", 15, 5), Field("func3", 12, 3), Field("rd", 7, 5),  Field("opcode", 0, 7)};
+    const FieldsType Form_V_uimm6::fields{makeFields(Form_V_uimm6::field_layout)};
 
     const std::map<std::string, const Field &> Form_V_uimm6::fmap{
         {"func5",  Form_V_uimm6::fields[Form_V_uimm6::idType::FUNC5] },
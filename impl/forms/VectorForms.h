@@ -30,6 +30,21 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func1a", 31, 1},
+            {"func1b", 30, 1},
+            {"func3a", 27, 3},
+            {"func1c", 26, 1},
+            {"vm",     25, 1},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"simm5",  15, 5},
+            {"func3b", 12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -58,6 +73,19 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"nf",     29, 3},
+            {"mewop",  26, 3},
+            {"vm",     25, 1},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"width",  12, 3},
+            {"rd",      7, 5},
+            {"rs3",     7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -83,6 +111,16 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func1",  31, 1},
+            {"imm11",  20, 11},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -108,6 +146,16 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func2",  30, 2},
+            {"imm10",  20, 10},
+            {"avl",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -133,6 +181,16 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func7",  25, 7},
+            {"rs2",    20, 5},
+            {"rs1",    15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -160,6 +218,18 @@ namespace mavis
         };
 
         static const char* name;
+
+        static constexpr std::array<FieldDescriptor, idType::__N> field_layout{{
+            {"func5",  27, 5},
+            {"i5",     26, 1},
+            {"vm",     25, 1},
+            {"rs2",    20, 5},
+            {"uimm5",  15, 5},
+            {"func3",  12, 3},
+            {"rd",      7, 5},
+            {"opcode",  0, 7},
+        }};
+
         static const FieldsType fields;
         static const std::map<std::string, const Field &> fmap;
         static const std::map<std::string, idType> imap;
@@ -5,8 +5,9 @@
 #include "InstMetaDataRegistry.hpp"
 #include "InstructionRegistry.hpp"
 #include "AnnotationRegistry.hpp"
-#include "DualKeyRegistry.hpp"
 #include "DecoderExceptions.h"
+#include <unordered_map>
+#include <vector>
 
 namespace mavis
 {
@@ -16,9 +17,19 @@ class FactoryBuilderBase
 {
     typedef std::shared_ptr<FactoryBuilderBase<FactoryType, InstType, AnnotationType, AnnotationTypeAllocator>>     PtrType;
     typedef AnnotationRegistry<AnnotationType,AnnotationTypeAllocator>          AnnotationRegistryType;
-    typedef DualKeyRegistry<typename FactoryType::PtrType>                UIDStashType;
+
+    // Growth increment for the UID-indexed factory table
+    static constexpr uint32_t UID_TABLE_UP_SIZE = 100;
 
 public:
+    // What a direct build by UID needs, resolved once at registration
+    struct InstructionVariant
+    {
+        typename FactoryType::PtrType       ifact;
+        InstMetaData::PtrType               meta;
+        typename AnnotationType::PtrType    anno;
+    };
+
     FactoryBuilderBase(const FileNameListType& anno_files,
                        AnnotationTypeAllocator & annotation_allocator,
                        const InstUIDList& uid_list = {},
@@ -53,6 +64,31 @@ public:
         return meta_registry_.lookup(mnemonic);
     }
 
+    // Record an overlay's base mnemonic and metadata (overlays have no metadata registered
+    // under their own mnemonic)
+    void registerOverlay(const std::string& mnemonic, const std::string& base_mnemonic,
+                         const InstMetaData::PtrType& meta)
+    {
+        overlays_[mnemonic] = {base_mnemonic, meta};
+    }
+
+    // Call callback(mnemonic, uid, meta, base_mnemonic) for every instruction that owns its UID.
+    // For overlays, meta is the overlay's metadata and base_mnemonic the instruction it
+    // overlays; otherwise base_mnemonic is the mnemonic itself
+    template<typename CallbackType>
+    void forEachInstruction(CallbackType&& callback) const
+    {
+        inst_registry_.forEachInst([this, &callback](const std::string& mnemonic,
+                                                     const InstructionUniqueID uid)
+        {
+            if (const auto olay = overlays_.find(mnemonic); olay != overlays_.end()) {
+                callback(mnemonic, uid, olay->second.meta, olay->second.base_mnemonic);
+            } else {
+                callback(mnemonic, uid, findMetaData(mnemonic), mnemonic);
+            }
+        });
+    }
+
     template<typename ...ArgTypes>
     InstMetaData::PtrType makeInstMetaData(ArgTypes&& ...args)
     {
@@ -69,29 +105,59 @@ public:
         }
     }
 
-    const typename FactoryType::PtrType findIFact(const InstructionUniqueID uid)
+    // uid_registry_ is filled as instructions are registered (see registerVariant()), so the
+    // reference stays valid until the next registration
+    const typename FactoryType::PtrType& findIFact(const InstructionUniqueID uid) const
     {
-        if (uid_stash_.contains(uid)) {
-            return uid_stash_.lookup(uid);
-        } else {
-            // Lazy add of ifact when first we fail to look up
-            const std::string& mnemonic = findInstructionMnemonic(uid);
-            const typename FactoryType::PtrType ifact = findIFact(mnemonic);
-            if (ifact != nullptr) {
-                uid_stash_.add(mnemonic, uid, ifact);
-            }
-            return ifact;
+        if (uid < uid_registry_.size()) [[likely]] {
+            return uid_registry_[uid].ifact;
+        }
+        return not_found_;
+    }
+
+    // Factory, metadata, and annotation of the instruction that owns the given UID (nullptr if
+    // no instruction owns it)
+    const InstructionVariant* findVariant(const InstructionUniqueID uid) const
+    {
+        if ((uid < uid_registry_.size()) && (uid_registry_[uid].ifact != nullptr)) [[likely]] {
+            return &uid_registry_[uid];
+        }
+        return nullptr;
+    }
+
+    // Record the factory, metadata, and annotation of the instruction owning the given UID. The
+    // first registration wins (an instruction may be built more than once)
+    void registerVariant(const InstructionUniqueID uid, const typename FactoryType::PtrType& ifact,
+                         const InstMetaData::PtrType& meta,
+                         const typename AnnotationType::PtrType& anno)
+    {
+        if (uid >= uid_registry_.size()) {
+            uid_registry_.resize(uid + UID_TABLE_UP_SIZE);
+        }
+        if (uid_registry_[uid].ifact == nullptr) {
+            uid_registry_[uid] = {ifact, meta, anno};
         }
     }
 
 protected:
-    std::map<std::string, typename FactoryType::PtrType>    registry_;
-    typename FactoryType::PtrType                           not_found_;
+    struct OverlayInfo
+    {
+        std::string             base_mnemonic;
+        InstMetaData::PtrType   meta;
+    };
+
+    std::unordered_map<std::string, typename FactoryType::PtrType>  registry_;
+    typename FactoryType::PtrType                                   not_found_;
 
     InstructionRegistry                                     inst_registry_;
     AnnotationRegistryType                                  anno_registry_;
     InstMetaDataRegistry                                    meta_registry_;
-    UIDStashType                                            uid_stash_;
+
+    // Dense table of instruction variants indexed by UID (populated by registerVariant())
+    std::vector<InstructionVariant>                         uid_registry_;
+
+    // Overlays by mnemonic (see registerOverlay())
+    std::unordered_map<std::string, OverlayInfo>            overlays_;
 };
 
 } // namespace mavis
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "DecoderConsts.h"
+#include "OpcodeInfo.h"
+
+#include <cinttypes>
+#include <type_traits>
+
+namespace mavis
+{
+
+    /**
+     * \brief Compact, trivially copyable summary of a decoded instruction
+     *
+     * Holds the pieces of OpcodeInfo most consumers need (UID, the RD/RS1/RS2/RS3 register
+     * numbers and operand types, immediate, instruction type bits, encoding size, and a few
+     * flags) in 32 bytes with no pointers. It can be stored in arrays, memcpy'd, and handed to
+     * other threads without any lifetime concerns. Obtain one with Mavis::decodeCompact().
+     *
+     * Registers other than RD/RS1/RS2/RS3 (e.g. the implied registers of Zcmp push/pop) are not
+     * represented; use OpcodeInfo for those.
+     */
+    struct CompactInst
+    {
+        using InstructionTypes = InstMetaData::InstructionTypes;
+        using OperandTypes = InstMetaData::OperandTypes;
+        using OperandFieldID = InstMetaData::OperandFieldID;
+        using ExtractedInstTypes = DecodedInstructionInfo::ExtractedInstTypes;
+
+        // Register number of an operand the instruction does not have
+        static constexpr uint8_t NO_REG = 0xff;
+
+        enum Flags : uint8_t
+        {
+            HAS_IMMEDIATE = 1u << 0,
+            SIGNED_IMMEDIATE = 1u << 1,
+            HINT = 1u << 2,
+            CALL = 1u << 3,
+            RETURN = 1u << 4,
+            INDIRECT = 1u << 5,
+            RS2_IS_STORE_DATA = 1u << 6
+        };
+
+        // Index of each register in regs[]
+        enum RegIndex : uint8_t
+        {
+            RD_IDX = 0,
+            RS1_IDX,
+            RS2_IDX,
+            RS3_IDX,
+            NUM_REGS
+        };
+
+        uint64_t immediate = 0; // Sign extended if SIGNED_IMMEDIATE is set
+        std::underlying_type_t<InstructionTypes> inst_types = 0;
+        InstructionUniqueID uid = INVALID_UID;
+        uint8_t regs[NUM_REGS] = {NO_REG, NO_REG, NO_REG, NO_REG};
+        uint16_t operand_types = 0; // 3 bits per register, in RegIndex order
+        uint8_t size = 0;           // Encoding size in bytes
+        uint8_t flags = 0;
+        ImmediateType immediate_type = ImmediateType::NONE;
+
+        bool isValid() const { return uid != INVALID_UID; }
+
+        bool hasFlag(Flags flag) const { return (flags & flag) != 0; }
+
+        bool isInstType(InstructionTypes itype) const
+        {
+            return (inst_types & static_cast<std::underlying_type_t<InstructionTypes>>(itype))
+                   != 0;
+        }
+
+        uint8_t getRd() const { return regs[RD_IDX]; }
+
+        uint8_t getRs1() const { return regs[RS1_IDX]; }
+
+        uint8_t getRs2() const { return regs[RS2_IDX]; }
+
+        uint8_t getRs3() const { return regs[RS3_IDX]; }
+
+        OperandTypes getOperandType(RegIndex idx) const
+        {
+            if (regs[idx] == NO_REG)
+            {
+                return OperandTypes::NONE;
+            }
+            return static_cast<OperandTypes>((operand_types >> (OPERAND_TYPE_BITS * idx))
+                                             & OPERAND_TYPE_MASK);
+        }
+
+        int64_t getSignedImmediate() const { return static_cast<int64_t>(immediate); }
+
+        /**
+         * \brief Encoding size (in bytes) of an opcode, from its low order bits. Matches the
+         * instruction-length families the decoder's top level selects between
+         */
+        static constexpr uint8_t getEncodingSize(const Opcode icode)
+        {
+            if ((icode & 0x3ull) != 0x3ull)
+            {
+                return 2;
+            }
+            else if ((icode & 0x1cull) != 0x1cull)
+            {
+                return 4;
+            }
+            else if ((icode & 0x3full) == 0x1full)
+            {
+                return 6;
+            }
+            else if ((icode & 0x7full) == 0x3full)
+            {
+                return 8;
+            }
+            return 0;
+        }
+
+        /**
+         * \brief Build the compact form of an instruction decoded from icode
+         */
+        static CompactInst build(const Opcode icode, const OpcodeInfo & opinfo)
+        {
+            CompactInst inst;
+            inst.uid = opinfo.getInstructionUniqueID();
+            inst.inst_types = opinfo.getInstType();
+            inst.size = getEncodingSize(icode);
+
+            inst.immediate_type = opinfo.getImmediateType();
+            if (inst.immediate_type != ImmediateType::NONE)
+            {
+                inst.flags |= HAS_IMMEDIATE;
+                if (inst.immediate_type == ImmediateType::SIGNED)
+                {
+                    inst.flags |= SIGNED_IMMEDIATE;
+                    inst.immediate = static_cast<uint64_t>(opinfo.getSignedOffset());
+                }
+                else
+                {
+                    inst.immediate = opinfo.getImmediate();
+                }
+            }
+            if (opinfo.isHint())
+            {
+                inst.flags |= HINT;
+            }
+            if (opinfo.isExtractedInstType(ExtractedInstTypes::CALL))
+            {
+                inst.flags |= CALL;
+            }
+            if (opinfo.isExtractedInstType(ExtractedInstTypes::RETURN))
+            {
+                inst.flags |= RETURN;
+            }
+            if (opinfo.isExtractedInstType(ExtractedInstTypes::INDIRECT))
+            {
+                inst.flags |= INDIRECT;
+            }
+
+            for (const auto & elem : opinfo.getSourceOpInfoList())
+            {
+                switch (elem.field_id)
+                {
+                    case OperandFieldID::RS1:
+                        inst.setReg_(RS1_IDX, elem);
+                        break;
+                    case OperandFieldID::RS2:
+                        inst.setReg_(RS2_IDX, elem);
+                        if (elem.is_store_data)
+                        {
+                            inst.flags |= RS2_IS_STORE_DATA;
+                        }
+                        break;
+                    case OperandFieldID::RS3:
+                        inst.setReg_(RS3_IDX, elem);
+                        break;
+                    default:
+                        break;
+                }
+            }
+            for (const auto & elem : opinfo.getDestOpInfoList())
+            {
+                if (elem.field_id == OperandFieldID::RD)
+                {
+                    inst.setReg_(RD_IDX, elem);
+                }
+            }
+            return inst;
+        }
+
+      private:
+        static constexpr uint32_t OPERAND_TYPE_BITS = 3;
+        static constexpr uint16_t OPERAND_TYPE_MASK = (1u << OPERAND_TYPE_BITS) - 1;
+        static_assert(static_cast<uint32_t>(OperandTypes::NONE) <= OPERAND_TYPE_MASK,
+                      "CompactInst: OperandTypes no longer fit in the packed operand types");
+
+        void setReg_(RegIndex idx, const OperandInfo::Element & elem)
+        {
+            regs[idx] = static_cast<uint8_t>(elem.field_value);
+            const uint32_t shift = OPERAND_TYPE_BITS * idx;
+            operand_types = (operand_types & ~(OPERAND_TYPE_MASK << shift))
+                            | (static_cast<uint16_t>(elem.operand_type) << shift);
+        }
+    };
+
+    static_assert(std::is_trivially_copyable_v<CompactInst>,
+                  "CompactInst must stay trivially copyable");
+    static_assert(sizeof(CompactInst) <= 32, "CompactInst must fit in 32 bytes");
+
+} // namespace mavis
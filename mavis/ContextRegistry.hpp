@@ -17,6 +17,33 @@ class ContextRegistry
     using DTableType = mavis::DTable<InstType, AnnotationType, AnnotationTypeAllocator>;
 
 public:
+    /**
+     * \brief The decoder state of one context. Contexts are never removed, so a reference to one
+     * stays valid for the life of the registry
+     */
+    struct Context {
+        typename BuilderType::PtrType           builder;
+        typename PseudoBuilderType::PtrType     pseudo_builder;
+        typename DTableType::PtrType            dtrie;
+
+        Context() = default;
+        Context(const Context&) = default;
+        Context& operator=(const Context&) = default;
+
+        Context(AnnotationTypeAllocator& anno_allocator, const FileNameListType& isa_files, const FileNameListType& anno_files,
+                const InstUIDList& uid_list = {}, const AnnotationOverrides & anno_overrides = {},
+                const MatchSet<Pattern>& inclusions = MatchSet<Pattern>(),
+                const MatchSet<Pattern>& exclusions = MatchSet<Pattern>())
+        {
+            builder = std::make_shared<BuilderType>(anno_files, anno_allocator, uid_list, anno_overrides);
+            dtrie   = std::make_shared<DTableType>(builder);
+            dtrie->configure(isa_files, inclusions, exclusions);
+
+            pseudo_builder = std::make_shared<PseudoBuilderType>(anno_files, anno_allocator, uid_list);
+            pseudo_builder->configure(isa_files);
+        }
+    };
+
     explicit ContextRegistry(const AnnotationTypeAllocator& anno_allocator) :
         annotation_allocator_(anno_allocator)
     {}
@@ -52,6 +79,18 @@ public:
         return iter != registry_.end();
     }
 
+    /**
+     * \brief Look up a context by name (e.g. to bind a DecodeView to it)
+     */
+    const Context& getContext(const std::string& name) const
+    {
+        const auto iter = registry_.find(name);
+        if (iter == registry_.end()) {
+            throw UnknownContext(name);
+        }
+        return iter->second;
+    }
+
     typename BuilderType::PtrType getBuilder() const
     {
         return mavis::utils::notNull(mavis::utils::notNull(current_)->builder);
@@ -70,29 +109,6 @@ public:
 private:
     AnnotationTypeAllocator annotation_allocator_;
 
-    struct Context {
-        typename BuilderType::PtrType           builder;
-        typename PseudoBuilderType::PtrType     pseudo_builder;
-        typename DTableType::PtrType            dtrie;
-
-        Context() = default;
-        Context(const Context&) = default;
-        Context& operator=(const Context&) = default;
-
-        Context(AnnotationTypeAllocator& anno_allocator, const FileNameListType& isa_files, const FileNameListType& anno_files,
-                const InstUIDList& uid_list = {}, const AnnotationOverrides & anno_overrides = {},
-                const MatchSet<Pattern>& inclusions = MatchSet<Pattern>(),
-                const MatchSet<Pattern>& exclusions = MatchSet<Pattern>())
-        {
-            builder = std::make_shared<BuilderType>(anno_files, anno_allocator, uid_list, anno_overrides);
-            dtrie   = std::make_shared<DTableType>(builder);
-            dtrie->configure(isa_files, inclusions, exclusions);
-
-            pseudo_builder = std::make_shared<PseudoBuilderType>(anno_files, anno_allocator, uid_list);
-            pseudo_builder->configure(isa_files);
-        }
-    };
-
     std::map<std::string, Context>     registry_;
     Context                            *current_ = nullptr;
 };
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <set>
 #include <boost/json.hpp>
+#include "CompactInst.hpp"
+#include "DecodeProfile.hpp"
 #include "FormRegistry.h"
 #include "FormPseudo.h"
 #include "IFactory.h"
@@ -21,6 +25,9 @@
 #include "Tag.hpp"
 #include "Pattern.hpp"
 #include "MatchSet.hpp"
+#include "StaticDecoderWriter.hpp"
+#include "DecodeImageWriter.hpp"
+#include "VectorInst.hpp"
 
 namespace mavis
 {
@@ -169,12 +176,86 @@ namespace mavis
         using IFactoryCache =
             Cache<typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo, CACHE_SIZE>;
 
+        // Direct-mapped memo of morphInst() results, tagged by UID, the owner of the instruction
+        // description (factory or metadata), and the operand signature of the direct info. The
+        // OpcodeInfo objects are immutable once built, so a hit is shared by every instruction
+        // morphed with the same operands
+        class MorphCache
+        {
+          private:
+            struct Line
+            {
+                InstructionUniqueID uid = INVALID_UID;
+                const void* owner = nullptr;
+                ExtractorDirectInfoIF::SignatureType sig;
+                OpcodeInfo::PtrType opinfo;
+                typename AnnotationType::PtrType uinfo;
+            };
+
+            std::array<Line, CACHE_SIZE> table_;
+            ExtractorDirectInfoIF::SignatureType scratch_;
+
+            static uint32_t hash_(const InstructionUniqueID uid, const void* owner,
+                                  const ExtractorDirectInfoIF::SignatureType & sig)
+            {
+                uint64_t h = (uid * 0x9e3779b97f4a7c15ull) ^ reinterpret_cast<uintptr_t>(owner);
+                for (const auto word : sig)
+                {
+                    h = (h ^ word) * 0x100000001b3ull;
+                    h ^= h >> 29;
+                }
+                return static_cast<uint32_t>(h % CACHE_SIZE);
+            }
+
+          public:
+            /**
+             * \brief Look up a memoized morph
+             * \return The cache line if it matches, nullptr otherwise. On a miss, the signature of
+             * ex_info is left in the scratch area for a subsequent allocate()
+             */
+            const Line* lookup(const InstructionUniqueID uid, const void* owner,
+                               const ExtractorDirectInfoIF & ex_info, bool & memoizable)
+            {
+                scratch_.clear();
+                memoizable = ex_info.appendSignature(scratch_);
+                if (!memoizable)
+                {
+                    return nullptr;
+                }
+                const Line & line = table_[hash_(uid, owner, scratch_)];
+                if ((line.opinfo != nullptr) && (line.uid == uid) && (line.owner == owner)
+                    && (line.sig == scratch_))
+                {
+                    return &line;
+                }
+                return nullptr;
+            }
+
+            // Fill the line for the signature left behind by the last (missed) lookup()
+            void allocate(const InstructionUniqueID uid, const void* owner,
+                          const OpcodeInfo::PtrType & opinfo,
+                          const typename AnnotationType::PtrType & uinfo)
+            {
+                Line & line = table_[hash_(uid, owner, scratch_)];
+                line.uid = uid;
+                line.owner = owner;
+                line.sig = scratch_;
+                line.opinfo = opinfo;
+                line.uinfo = uinfo;
+            }
+        };
+
       public:
         explicit DTable(typename IFactoryBuilder<InstType, AnnotationType,
                                                  AnnotationTypeAllocator>::PtrType builder) :
             builder_(builder),
             icache_(new InstCache()),
-            ocache_(new IFactoryCache())
+            ocache_(new IFactoryCache()),
+            info_refs_(new InfoRefCache()),
+            compact_cache_(new CompactCache()),
+            class_cache_(new ClassificationCache()),
+            vector_cache_(new VectorCache()),
+            morph_cache_(new MorphCache())
         {
             // Form<'*'>   form;
             // root_ = new IFactoryDenseComposite(form.getField(Form<'*'>::FAMILY));
@@ -210,7 +291,8 @@ namespace mavis
                     [](uint32_t icode)
                     { return ((icode & 0x7ful) == 0x7ful) && ((icode & 0x7000ul) != 0x7000ul); },
                     [](uint32_t icode) { return (icode & 0x707ful) == 0x707ful; },
-                }));
+                },
+                0x707f)); // The bits the matchers above look at
 #endif
         }
 
@@ -243,6 +325,89 @@ namespace mavis
             }
         }
 
+        /**
+         * \brief Like getInfo(), but returns a reference rather than a copy of the shared
+         * pointer, so repeated queries do no reference counting. The DTable retains the info for
+         * every opcode looked up this way; the reference stays valid until flushCaches()
+         */
+        const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo &
+        getInfoRef(const Opcode icode)
+        {
+            InfoRefLine & line = (*info_refs_)[icode % CACHE_SIZE];
+            if ((line.info != nullptr) && (line.tag == icode))
+            {
+                return *line.info;
+            }
+
+            auto itr = retained_info_.find(icode);
+            if (itr == retained_info_.end())
+            {
+                itr = retained_info_.emplace(icode, getInfo(icode)).first;
+            }
+            line.tag = icode;
+            line.info = itr->second.get();
+            return *line.info;
+        }
+
+        /**
+         * \brief Decode icode into its compact (pointer-free) form. The compact forms have a
+         * direct-mapped cache of their own; a miss decodes through getInfo()
+         */
+        CompactInst decodeCompact(const Opcode icode)
+        {
+            CompactLine & line = (*compact_cache_)[icode % CACHE_SIZE];
+            if ((line.tag != icode) || !line.inst.isValid())
+            {
+                line.inst = CompactInst::build(icode, *getInfo(icode)->opinfo);
+                line.tag = icode;
+            }
+            return line.inst;
+        }
+
+        /**
+         * \brief Instruction type bits of an opcode (InstMetaData::InstructionTypes plus
+         * DecodedInstructionInfo::ExtractedInstTypes)
+         */
+        typedef typename IFactoryIF<InstType, AnnotationType>::TypeBits Classification;
+
+        /**
+         * \brief Classify icode through a direct-mapped table of its own. A hit involves no
+         * allocation and no reference counting; a miss walks the trie for the type bits only
+         * (IFactoryIF::getTypes()), without building decoded info or filling the other caches.
+         * Unlike getInfoRef(), nothing is retained per opcode, so classifying arbitrary (e.g.
+         * wrong-path) opcodes does not grow memory
+         */
+        const Classification & classify(const Opcode icode)
+        {
+            ClassificationLine & line = (*class_cache_)[icode % CACHE_SIZE];
+            if (!line.valid || (line.tag != icode))
+            {
+                line.types = root_->getTypes(icode);
+                line.tag = icode;
+                line.valid = true;
+            }
+            return line.types;
+        }
+
+        /**
+         * \brief Resolve the vector register groups of icode under vtype (see VectorInst),
+         * through a direct-mapped cache tagged by (opcode, vtype). A miss decodes through
+         * getInfo(). Returned by value: a later call may evict the line
+         */
+        VectorInst decodeVector(const Opcode icode, const uint64_t vtype)
+        {
+            const uint64_t key = (vtype * 0x9e3779b97f4a7c15ull) ^ icode;
+            VectorLine & line = (*vector_cache_)[key % CACHE_SIZE];
+            if (!line.valid || (line.tag != icode) || (line.vtype != vtype))
+            {
+                line.inst = VectorInst::build(*getInfo(icode)->opinfo, vtype);
+                line.tag = icode;
+                line.vtype = vtype;
+                line.valid = true;
+            }
+            return line.inst;
+        }
+
         template <class InstTypeAllocator, typename... ArgTypes>
         typename InstType::PtrType makeInst(const Opcode icode, InstTypeAllocator & allocator,
                                             ArgTypes &&... args)
@@ -281,6 +446,26 @@ namespace mavis
             }
         }
 
+        /**
+         * \brief Decode into an existing instruction (through InstType::morph()) instead of
+         * allocating a new one. Only the decode information (OpcodeInfo and annotation) is
+         * replaced; as with morphInst(), any other state in the instruction is left alone
+         */
+        void decodeInto(const Opcode icode, InstType & inst)
+        {
+            const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType & ohandle =
+                ocache_->lookup(icode);
+            if (ohandle != nullptr)
+            {
+                inst.morph(ohandle->opinfo, ohandle->uinfo);
+            }
+            else
+            {
+                const auto info = getInfo(icode);
+                inst.morph(info->opinfo, info->uinfo);
+            }
+        }
+
         /**
          * makeInstFromTrace -- use information from trace to generate an instruction
          * @tparam TraceInfoType
@@ -292,29 +477,42 @@ namespace mavis
                                                      InstTypeAllocator & allocator,
                                                      ArgTypes &&... args)
         {
-            // First, try to decode the binary opcode normally
-            // This is the most efficient avenue
-            auto inst = makeInst(tinfo.getOpcode(), allocator, std::forward<ArgTypes>(args)...);
+            // First, decode the binary opcode normally (through the opcode cache) and check the
+            // decoded instruction against the trace's expectations by UID. The trace mnemonic is
+            // resolved to a UID only the first time it is seen
+            const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType & info =
+                getInfo(tinfo.getOpcode());
+            TraceMnemonicInfo & trace_info = trace_mnemonics_[tinfo.getMnemonic()];
+            if (!trace_info.resolved)
+            {
+                trace_info.uid = builder_->findInstructionUID(tinfo.getMnemonic());
+                trace_info.resolved = true;
+            }
+            if ((trace_info.uid != INVALID_UID)
+                && (trace_info.uid == info->opinfo->getInstructionUniqueID()))
+            {
+                // This is the most efficient avenue
+                return makeInst(tinfo.getOpcode(), allocator, std::forward<ArgTypes>(args)...);
+            }
 
-            // Sanity check our instruction against the trace's expectations
-            // if (inst == nullptr || (std::string(inst->getMnemonic()) != tinfo.getMnemonic())) {
-            if (std::string(inst->getMnemonic()) != tinfo.getMnemonic())
+            // We didn't match the trace, so we'll let the trace override ours. The override is
+            // built once per (mnemonic, opcode)
+            typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType & override_info =
+                trace_info.overrides[tinfo.getOpcode()];
+            if (override_info == nullptr)
             {
-                // We didn't match the trace, so we'll let the trace
-                // override ours
                 // TODO: Need a real einfo here!
                 InstMetaData::PtrType einfo(new InstMetaData(InstMetaData::ISA::RV32I));
                 typename IFactoryIF<InstType, AnnotationType>::PtrType ifact =
                     builder_->build(tinfo.getMnemonic(), tinfo.getMnemonic(), "", 0, einfo);
                 ExtractorIF::PtrType extractor(new ExtractorTraceInfo<TraceInfoType>(tinfo));
-                const typename IFactory<InstType, AnnotationType>::IFactoryInfo::PtrType & info =
-                    ifact->getInfo(tinfo.getMnemonic(), tinfo.getOpcode(), extractor);
+                override_info = ifact->getInfo(tinfo.getMnemonic(), tinfo.getOpcode(), extractor);
 
-                inst = allocator(info->opinfo, info->uinfo, std::forward<ArgTypes>(args)...);
-                icache_->allocate(tinfo.getOpcode(), inst);
+                // Building the factory registers the mnemonic if it was unknown
+                trace_info.uid = builder_->findInstructionUID(tinfo.getMnemonic());
             }
-
-            return inst;
+            return allocator(override_info->opinfo, override_info->uinfo,
+                             std::forward<ArgTypes>(args)...);
         }
 
         /**
@@ -327,37 +525,68 @@ namespace mavis
                                                     InstTypeAllocator & allocator,
                                                     ArgTypes &&... args)
         {
-            typename InstType::PtrType inst = nullptr;
-
-            std::string mnemonic = ex_info.getMnemonic();
             const InstructionUniqueID uid = ex_info.getUID();
-
-            // Try to look up the factory by UID (if present)
-            typename IFactory<InstType, AnnotationType>::PtrType ifact = nullptr;
-            if (uid != mavis::INVALID_UID)
-            {
-                mnemonic = builder_->findInstructionMnemonic(uid);
-                ifact = builder_->findIFact(uid);
-            }
-            else
+            if (uid != INVALID_UID)
             {
-                // Look up the factory for the given mnemonic
-                ifact = builder_->findIFact(mnemonic);
+                const auto & variant = findDirectVariant_(uid);
+                const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType &
+                    info = getDirectInfo_(variant, uid, ex_info);
+                return allocator(info->opinfo, info->uinfo, std::forward<ArgTypes>(args)...);
             }
 
-            // Look up the factory for the given mnemonic
+            const std::string mnemonic = ex_info.getMnemonic();
+            const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType & info =
+                findDirectIFact_(mnemonic)->getInfoBypassCache(mnemonic, ex_info.clone());
+            return allocator(info->opinfo, info->uinfo, std::forward<ArgTypes>(args)...);
+        }
+
+        /**
+         * \brief Build an instruction from a prepared handle
+         * \param handle Handle from prepareDirect() (or Mavis::preparePseudoInst())
+         * \param operands Operand values (its mnemonic/UID are ignored)
+         * \return
+         */
+        template <class InstTypeAllocator, typename... ArgTypes>
+        typename InstType::PtrType makeInstDirectly(const DirectInstHandle<AnnotationType> & handle,
+                                                    const ExtractorDirectInfoIF & operands,
+                                                    InstTypeAllocator & allocator,
+                                                    ArgTypes &&... args) const
+        {
+            return allocator(getDirectOpInfo_(handle, operands), handle.getAnnotation(),
+                             std::forward<ArgTypes>(args)...);
+        }
+
+        /**
+         * \brief Resolve a handle for building the given instruction directly
+         * \param uid Instruction UID
+         * \return
+         */
+        DirectInstHandle<AnnotationType> prepareDirect(const InstructionUniqueID uid) const
+        {
+            const std::string & mnemonic = builder_->findInstructionMnemonic(uid);
+            const typename IFactory<InstType, AnnotationType>::PtrType & ifact =
+                builder_->findIFact(uid);
             if (ifact == nullptr)
             {
                 throw UnknownMnemonic(mnemonic);
             }
-            else
+            return ifact->prepareDirect(mnemonic);
+        }
+
+        /**
+         * \brief Resolve a handle for building the given instruction directly
+         * \param mnemonic Instruction mnemonic
+         * \return
+         */
+        DirectInstHandle<AnnotationType> prepareDirect(const std::string & mnemonic) const
+        {
+            const typename IFactory<InstType, AnnotationType>::PtrType & ifact =
+                builder_->findIFact(mnemonic);
+            if (ifact == nullptr)
             {
-                const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType & info =
-                    ifact->getInfoBypassCache(mnemonic, ex_info.clone());
-                inst = allocator(info->opinfo, info->uinfo, std::forward<ArgTypes>(args)...);
+                throw UnknownMnemonic(mnemonic);
             }
-
-            return inst;
+            return ifact->prepareDirect(mnemonic);
         }
 
         /**
@@ -367,33 +596,168 @@ namespace mavis
          */
         void morphInst(typename InstType::PtrType inst, const ExtractorDirectInfoIF & ex_info) const
         {
-            // Look up the factory for the given mnemonic
-            typename IFactory<InstType, AnnotationType>::PtrType ifact =
-                builder_->findIFact(ex_info.getMnemonic());
-            if (ifact == nullptr)
+            bool memoizable = false;
+            const InstructionUniqueID uid = ex_info.getUID();
+            if (uid != INVALID_UID)
+            {
+                const auto & variant = findDirectVariant_(uid);
+                const auto* line =
+                    morph_cache_->lookup(uid, variant.ifact.get(), ex_info, memoizable);
+                if (line != nullptr)
+                {
+                    inst->morph(line->opinfo, line->uinfo);
+                    return;
+                }
+                const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType &
+                    info = getDirectInfo_(variant, uid, ex_info);
+                if (memoizable)
+                {
+                    morph_cache_->allocate(uid, variant.ifact.get(), info->opinfo, info->uinfo);
+                }
+                inst->morph(info->opinfo, info->uinfo);
+                return;
+            }
+
+            const std::string mnemonic = ex_info.getMnemonic();
+            const typename IFactory<InstType, AnnotationType>::PtrType & ifact =
+                findDirectIFact_(mnemonic);
+
+            // Compressed instructions share the UID of their expansion, so the factory is part
+            // of the memo tag
+            const InstructionUniqueID inst_uid = builder_->findInstructionUID(mnemonic);
+            const auto* line = morph_cache_->lookup(inst_uid, ifact.get(), ex_info, memoizable);
+            if (line != nullptr)
             {
-                throw UnknownMnemonic(ex_info.getMnemonic());
+                inst->morph(line->opinfo, line->uinfo);
+                return;
             }
-            else
+
+            // We should not need to invalidate the instruction cache for this instruction,
+            // since what we cache is a pristine version of the instruction generated from the
+            // opcode (see makeInst() above).
+            const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType & info =
+                ifact->getInfoBypassCache(mnemonic, ex_info.clone());
+            if (memoizable)
             {
-                // We should not need to invalidate the instruction cache for this instruction,
-                // since what we cache is a pristine version of the instruction generated from the
-                // opcode (see makeInst() above).
-                const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType & info =
-                    ifact->getInfoBypassCache(ex_info.getMnemonic(), ex_info.clone());
-                inst->morph(info->opinfo, info->uinfo);
+                morph_cache_->allocate(inst_uid, ifact.get(), info->opinfo, info->uinfo);
             }
+            inst->morph(info->opinfo, info->uinfo);
+        }
+
+        /**
+         * \brief Morph an existing instruction using a prepared handle and new operand values
+         * \param inst
+         * \param handle Handle from prepareDirect()
+         * \param operands Operand values (its mnemonic/UID are ignored)
+         */
+        void morphInst(typename InstType::PtrType inst,
+                       const DirectInstHandle<AnnotationType> & handle,
+                       const ExtractorDirectInfoIF & operands) const
+        {
+            inst->morph(getDirectOpInfo_(handle, operands), handle.getAnnotation());
         }
 
         void flushCaches()
         {
             icache_.reset(new InstCache());
             ocache_.reset(new IFactoryCache());
+            info_refs_.reset(new InfoRefCache());
+            retained_info_.clear();
+            compact_cache_.reset(new CompactCache());
+            class_cache_.reset(new ClassificationCache());
+            vector_cache_.reset(new VectorCache());
+            morph_cache_.reset(new MorphCache());
+            trace_mnemonics_.clear();
             root_->flushCaches();
         }
 
+        /**
+         * \brief Pre-warm the opcode-tagged decode caches (getInfo(), decodeCompact(),
+         * classify()) with the hottest opcodes of a recorded profile. The caches are
+         * direct-mapped, so each line is given the hottest profiled opcode that maps to it;
+         * opcodes this configuration cannot decode are skipped. The makeInst() prototype cache is
+         * left alone, since its prototypes are built with the caller's constructor arguments. A
+         * later flushCaches() discards the warmed lines
+         * \return The number of opcodes loaded
+         */
+        size_t prewarm(const DecodeProfile & profile)
+        {
+            std::vector<bool> claimed(CACHE_SIZE, false);
+            size_t num_claimed = 0;
+            for (const auto & [icode, count] : profile.getHottest(profile.size()))
+            {
+                if (num_claimed == CACHE_SIZE)
+                {
+                    break;
+                }
+                const uint32_t slot = icode % CACHE_SIZE;
+                if (claimed[slot])
+                {
+                    continue;
+                }
+                try
+                {
+                    decodeCompact(icode);
+                    classify(icode);
+                }
+                catch (const BaseException &)
+                {
+                    continue;
+                }
+                claimed[slot] = true;
+                ++num_claimed;
+            }
+            return num_claimed;
+        }
+
         void print(std::ostream & os) const { root_->print(os); }
 
+        /**
+         * \brief Write the decode trie out as a standalone C++ decoder (see StaticDecoderWriter)
+         */
+        void writeStaticDecoder(std::ostream & os, const std::string & class_name,
+                                const std::string & description) const
+        {
+            StaticDecoderWriter<InstType, AnnotationType>(class_name, description).write(os, root_);
+        }
+
+        /**
+         * \brief Flatten the decode trie into a pointer-free image (see DecodeImageWriter)
+         */
+        std::vector<uint32_t> buildDecodeImage(const std::string & description) const
+        {
+            return DecodeImageWriter<InstType, AnnotationType>(description).build(root_);
+        }
+
+        void writeDecodeImage(std::ostream & os, const std::string & description) const
+        {
+            DecodeImageWriter<InstType, AnnotationType>(description).write(os, root_);
+        }
+
+        /**
+         * \brief Shape of the decode trie
+         */
+        TrieStats getTrieStats() const
+        {
+            TrieStats stats;
+            root_->gatherStats(stats, 0);
+            return stats;
+        }
+
+        /**
+         * \brief Restructure the decode trie for faster lookup (see IFactoryIF::optimize()):
+         * drop pass-through nodes, collapse single-child chains, merge adjacent fields, and
+         * store sparse nodes as sorted arrays. Decode results do not change, but the trie can no
+         * longer be extended, so this must be done after configure()
+         * \return The trie's shape before and after
+         */
+        std::pair<TrieStats, TrieStats> optimize()
+        {
+            const TrieStats before = getTrieStats();
+            root_ = root_->optimize(root_);
+            return {before, getTrieStats()};
+        }
+
       private:
         typename IFactoryIF<InstType, AnnotationType>::PtrType root_ = nullptr;
         typename IFactoryBuilder<InstType, AnnotationType, AnnotationTypeAllocator>::PtrType
@@ -405,6 +769,146 @@ namespace mavis
         std::unique_ptr<InstCache> icache_;
         std::unique_ptr<IFactoryCache> ocache_;
 
+        // getInfoRef() support: every IFactoryInfo handed out by reference is retained (by
+        // opcode) until the next flush, with a direct-mapped cache of raw pointers in front
+        struct InfoRefLine
+        {
+            Opcode tag = 0;
+            const typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo* info = nullptr;
+        };
+
+        using InfoRefCache = std::array<InfoRefLine, CACHE_SIZE>;
+        std::unique_ptr<InfoRefCache> info_refs_;
+        std::unordered_map<Opcode,
+                           typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType>
+            retained_info_;
+
+        // decodeCompact() support: direct-mapped cache of compact forms, tagged by opcode
+        struct CompactLine
+        {
+            Opcode tag = 0;
+            CompactInst inst;
+        };
+
+        using CompactCache = std::array<CompactLine, CACHE_SIZE>;
+        std::unique_ptr<CompactCache> compact_cache_;
+
+        // classify() support: direct-mapped table of type bits, tagged by opcode
+        struct ClassificationLine
+        {
+            Opcode tag = 0;
+            Classification types;
+            bool valid = false;
+        };
+
+        using ClassificationCache = std::array<ClassificationLine, CACHE_SIZE>;
+        std::unique_ptr<ClassificationCache> class_cache_;
+
+        // decodeVector() support: direct-mapped cache of resolved vector operands, tagged by
+        // opcode and vtype
+        struct VectorLine
+        {
+            Opcode tag = 0;
+            uint64_t vtype = 0;
+            VectorInst inst;
+            bool valid = false;
+        };
+
+        using VectorCache = std::array<VectorLine, CACHE_SIZE>;
+        std::unique_ptr<VectorCache> vector_cache_;
+
+        // Trace mnemonics seen by makeInstFromTrace(): the resolved UID, plus any trace
+        // overrides (trace disagreed with our decode) by opcode
+        struct TraceMnemonicInfo
+        {
+            bool resolved = false;
+            InstructionUniqueID uid = INVALID_UID;
+            std::unordered_map<Opcode,
+                               typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType>
+                overrides;
+        };
+
+        std::unordered_map<std::string, TraceMnemonicInfo> trace_mnemonics_;
+
+        // Memo of morphInst() results, tagged by UID and operand signature (updated by the
+        // const morphInst() calls)
+        std::unique_ptr<MorphCache> morph_cache_;
+
+        /**
+         * \brief Get the OpcodeInfo for a handle and a set of operand values, memoized in the
+         * morph cache (tagged by the handle's metadata) when the operands allow it
+         */
+        OpcodeInfo::PtrType getDirectOpInfo_(const DirectInstHandle<AnnotationType> & handle,
+                                             const ExtractorDirectInfoIF & operands) const
+        {
+            if (!handle.isValid()) [[unlikely]]
+            {
+                throw UnknownMnemonic(handle.getMnemonic());
+            }
+            bool memoizable = false;
+            const auto* line = morph_cache_->lookup(handle.getUID(), handle.getMetaData().get(),
+                                                    operands, memoizable);
+            if (line != nullptr)
+            {
+                return line->opinfo;
+            }
+
+            OpcodeInfo::PtrType opinfo = handle.makeOpcodeInfo(operands);
+            if (memoizable)
+            {
+                morph_cache_->allocate(handle.getUID(), handle.getMetaData().get(), opinfo,
+                                       handle.getAnnotation());
+            }
+            return opinfo;
+        }
+
+        typedef typename IFactoryBuilder<InstType, AnnotationType,
+                                         AnnotationTypeAllocator>::InstructionVariant
+            DirectVariant;
+
+        /**
+         * \brief Find the instruction variant owning a UID for direct instruction creation
+         * (throws UnknownMnemonic if there is none)
+         */
+        const DirectVariant & findDirectVariant_(const InstructionUniqueID uid) const
+        {
+            const DirectVariant* variant = builder_->findVariant(uid);
+            if (variant == nullptr)
+            {
+                throw UnknownMnemonic(builder_->findInstructionMnemonic(uid));
+            }
+            return *variant;
+        }
+
+        /**
+         * \brief Find the factory for direct instruction creation by mnemonic (throws
+         * UnknownMnemonic if there is none)
+         */
+        const typename IFactory<InstType, AnnotationType>::PtrType &
+        findDirectIFact_(const std::string & mnemonic) const
+        {
+            const typename IFactory<InstType, AnnotationType>::PtrType & ifact =
+                builder_->findIFact(mnemonic);
+            if (ifact == nullptr)
+            {
+                throw UnknownMnemonic(mnemonic);
+            }
+            return ifact;
+        }
+
+        /**
+         * \brief Build the decode info of a direct instruction given by UID. Everything but the
+         * operands comes from the builder's UID-indexed variant table
+         */
+        typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
+        getDirectInfo_(const DirectVariant & variant, const InstructionUniqueID uid,
+                       const ExtractorDirectInfoIF & ex_info) const
+        {
+            return variant.ifact->getInfoBypassCache(builder_->findInstructionMnemonic(uid), uid,
+                                                     variant.meta, variant.anno,
+                                                     ex_info.clone());
+        }
+
         void parseInstInfo_(const std::string & jfile, const boost::json::object & inst,
                             const std::string & mnemonic, const MatchSet<Tag> & tags);
 
@@ -0,0 +1,433 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "DecoderExceptions.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief Read-only, pointer-free decode image: the decode trie of a configured Mavis
+     * instance (see DecodeImageWriter) flattened into an array of 32-bit words, with the
+     * mnemonics and UIDs of its instructions
+     *
+     * Every reference in the image is a word offset, so the image is position independent and
+     * decode() never writes to it. Map a file with map() and any number of processes share one
+     * physical copy (and nothing dirties the pages after a fork, unlike a trie held together by
+     * shared_ptrs).
+     *
+     * decode() returns an instruction index (or UNKNOWN / ILLEGAL), like a generated static
+     * decoder. Operands are not decoded; use the index to identify the instruction and map it to
+     * the UIDs of the local Mavis instance with getMnemonic().
+     *
+     * Words are stored in host byte order; the magic number catches a foreign-endian image.
+     */
+    class DecodeImage
+    {
+      public:
+        static constexpr uint32_t UNKNOWN = 0xffffffff;
+        static constexpr uint32_t ILLEGAL = 0xfffffffe;
+
+        static constexpr uint32_t MAGIC = 0x4944564d; // "MVDI"
+        static constexpr uint32_t VERSION = 1;
+
+        // Header words
+        enum Header : uint32_t
+        {
+            H_MAGIC,
+            H_VERSION,
+            H_NUM_WORDS,
+            H_ROOT,
+            H_NUM_INSTS,
+            H_INSTS,       // Word offset of the instruction table (INST_WORDS words each)
+            H_STRINGS,     // Word offset of the string area
+            H_STRINGS_LEN, // Size of the string area in bytes
+            H_DESCRIPTION, // Byte offset of the description in the string area
+            H_DESCRIPTION_LEN,
+            H_NUM_NODES,
+            H_RESERVED,
+            HEADER_WORDS
+        };
+
+        // Instruction table entry: mnemonic (byte offset and length in the string area), UID in
+        // the generating Mavis instance, example encoding
+        enum InstWord : uint32_t
+        {
+            I_NAME,
+            I_NAME_LEN,
+            I_UID,
+            I_EXAMPLE,
+            INST_WORDS
+        };
+
+        /**
+         * \brief Node kinds (first word of a node). A reference is a node's word offset, or
+         * RESULT | instruction index, UNKNOWN, or ILLEGAL
+         *
+         *  - TABLE:    [kind, shift, mask, default, refs[mask + 1]]
+         *              refs[(icode >> shift) & mask]; the default if that yields UNKNOWN
+         *  - SWITCH:   [kind, mask, default, n, (value, ref) * n], sorted by value
+         *              the ref whose value is (icode & mask); the default if none or UNKNOWN
+         *  - CASES:    [kind, default, n, (mask, value, ref) * n]
+         *              the first ref with (icode & mask) == value, else the default
+         *  - RESERVED: [kind, mask, list_bad, next, n, values * n], sorted
+         *              ILLEGAL iff ((icode & mask) is one of values) == list_bad, else next
+         */
+        enum NodeKind : uint32_t
+        {
+            TABLE = 1,
+            SWITCH,
+            CASES,
+            RESERVED
+        };
+
+        static constexpr uint32_t RESULT = 0x80000000;
+
+        DecodeImage() = default;
+
+        /**
+         * \brief Map an image file read-only and shared (see DecodeImageWriter::write())
+         * \throws BadDecodeImage
+         */
+        static DecodeImage map(const std::string & fname)
+        {
+            const int fd = ::open(fname.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw BadDecodeImage(fname, "cannot open");
+            }
+            struct stat st;
+            if ((::fstat(fd, &st) != 0) || (st.st_size == 0))
+            {
+                ::close(fd);
+                throw BadDecodeImage(fname, "cannot stat, or empty");
+            }
+            const size_t len = st.st_size;
+            void* addr = ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (addr == MAP_FAILED)
+            {
+                throw BadDecodeImage(fname, "mmap failed");
+            }
+            std::shared_ptr<const void> storage(addr, [len](const void* p)
+                                                { ::munmap(const_cast<void*>(p), len); });
+            return DecodeImage(std::move(storage), len, fname);
+        }
+
+        /**
+         * \brief Read an image into private memory
+         * \throws BadDecodeImage
+         */
+        static DecodeImage read(std::istream & is, const std::string & name = "<stream>")
+        {
+            const std::string bytes((std::istreambuf_iterator<char>(is)),
+                                    std::istreambuf_iterator<char>());
+            std::vector<uint32_t> words(bytes.size() / sizeof(uint32_t));
+            if (words.size() * sizeof(uint32_t) != bytes.size())
+            {
+                throw BadDecodeImage(name, "size is not a whole number of words");
+            }
+            std::memcpy(words.data(), bytes.data(), bytes.size());
+            return fromWords(std::move(words), name);
+        }
+
+        /**
+         * \brief Wrap image words built in memory (DecodeImageWriter::build())
+         * \throws BadDecodeImage
+         */
+        static DecodeImage fromWords(std::vector<uint32_t> words,
+                                     const std::string & name = "<memory>")
+        {
+            const size_t len = words.size() * sizeof(uint32_t);
+            const auto owned = std::make_shared<const std::vector<uint32_t>>(std::move(words));
+            return DecodeImage(std::shared_ptr<const void>(owned, owned->data()), len, name);
+        }
+
+        /**
+         * \brief Decode an opcode
+         * \return Instruction index (< getNumInsts()), UNKNOWN, or ILLEGAL
+         */
+        uint32_t decode(const Opcode icode) const { return eval_(words_[H_ROOT], icode); }
+
+        uint32_t getNumInsts() const { return words_[H_NUM_INSTS]; }
+
+        std::string_view getMnemonic(const uint32_t index) const
+        {
+            const uint32_t* inst = inst_(index);
+            return string_(inst[I_NAME], inst[I_NAME_LEN]);
+        }
+
+        // UID of the instruction in the Mavis instance the image was built from
+        InstructionUniqueID getUID(const uint32_t index) const { return inst_(index)[I_UID]; }
+
+        // An opcode with the fixed bits of the instruction's encoding
+        Opcode getExample(const uint32_t index) const { return inst_(index)[I_EXAMPLE]; }
+
+        std::string_view getDescription() const
+        {
+            return string_(words_[H_DESCRIPTION], words_[H_DESCRIPTION_LEN]);
+        }
+
+        size_t getNumNodes() const { return words_[H_NUM_NODES]; }
+
+        size_t getSizeInBytes() const { return num_words_ * sizeof(uint32_t); }
+
+        // The raw image (e.g. to copy it into memory placed elsewhere)
+        std::span<const uint32_t> getWords() const { return {words_, num_words_}; }
+
+        bool empty() const { return words_ == nullptr; }
+
+      private:
+        std::shared_ptr<const void> storage_;
+        const uint32_t* words_ = nullptr;
+        size_t num_words_ = 0;
+
+        DecodeImage(std::shared_ptr<const void> storage, const size_t len,
+                    const std::string & name) :
+            storage_(std::move(storage)),
+            words_(static_cast<const uint32_t*>(storage_.get())),
+            num_words_(len / sizeof(uint32_t))
+        {
+            validate_(len, name);
+        }
+
+        const uint32_t* inst_(const uint32_t index) const
+        {
+            return words_ + words_[H_INSTS] + (index * INST_WORDS);
+        }
+
+        std::string_view string_(const uint32_t offset, const uint32_t len) const
+        {
+            return std::string_view(reinterpret_cast<const char*>(words_ + words_[H_STRINGS])
+                                        + offset,
+                                    len);
+        }
+
+        static bool isNode_(const uint32_t ref) { return (ref & RESULT) == 0; }
+
+        uint32_t eval_(uint32_t ref, const Opcode icode) const
+        {
+            while (isNode_(ref))
+            {
+                const uint32_t* node = words_ + ref;
+                switch (node[0])
+                {
+                    case TABLE:
+                        {
+                            const uint32_t child = node[4 + ((icode >> node[1]) & node[2])];
+                            ref = node[3];
+                            if (ref == UNKNOWN)
+                            {
+                                ref = child;
+                            }
+                            else if (const uint32_t r = eval_(child, icode); r != UNKNOWN)
+                            {
+                                return r;
+                            }
+                        }
+                        break;
+                    case SWITCH:
+                        {
+                            const uint32_t child = switchLookup_(node, icode);
+                            ref = node[2];
+                            if (ref == UNKNOWN)
+                            {
+                                ref = child;
+                            }
+                            else if (const uint32_t r = eval_(child, icode); r != UNKNOWN)
+                            {
+                                return r;
+                            }
+                        }
+                        break;
+                    case CASES:
+                        {
+                            const uint32_t* c = node + 3;
+                            const uint32_t* const end = c + (node[2] * 3);
+                            while ((c != end) && ((icode & c[0]) != c[1]))
+                            {
+                                c += 3;
+                            }
+                            ref = (c != end) ? c[2] : node[1];
+                        }
+                        break;
+                    default: // RESERVED
+                        {
+                            const uint32_t* values = node + 5;
+                            const bool listed =
+                                std::binary_search(values, values + node[4], icode & node[1]);
+                            if (listed == (node[2] != 0))
+                            {
+                                return ILLEGAL;
+                            }
+                            ref = node[3];
+                        }
+                        break;
+                }
+            }
+            return (ref >= ILLEGAL) ? ref : (ref & ~RESULT);
+        }
+
+        static uint32_t switchLookup_(const uint32_t* node, const Opcode icode)
+        {
+            const uint32_t value = icode & node[1];
+            uint32_t lo = 0;
+            uint32_t hi = node[3];
+            const uint32_t* pairs = node + 4;
+            while (lo < hi)
+            {
+                const uint32_t mid = (lo + hi) / 2;
+                if (pairs[mid * 2] < value)
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            return ((lo < node[3]) && (pairs[lo * 2] == value)) ? pairs[(lo * 2) + 1] : UNKNOWN;
+        }
+
+        // Bounds-check the header and every node reachable from the root, so a truncated or
+        // corrupt file is rejected here rather than read out of bounds in decode()
+        void validate_(const size_t len, const std::string & name) const
+        {
+            const auto fail = [&name](const std::string & reason)
+            { throw BadDecodeImage(name, reason); };
+
+            if ((len % sizeof(uint32_t) != 0) || (num_words_ < HEADER_WORDS))
+            {
+                fail("truncated header");
+            }
+            if (words_[H_MAGIC] != MAGIC)
+            {
+                fail("bad magic number (not an image, or written on a host of other endianness)");
+            }
+            if (words_[H_VERSION] != VERSION)
+            {
+                fail("unsupported version " + std::to_string(words_[H_VERSION]));
+            }
+            if (words_[H_NUM_WORDS] != num_words_)
+            {
+                fail("size does not match header");
+            }
+            const uint64_t num_insts = words_[H_NUM_INSTS];
+            const uint64_t strings_end =
+                (uint64_t(words_[H_STRINGS]) * sizeof(uint32_t)) + words_[H_STRINGS_LEN];
+            if ((uint64_t(words_[H_INSTS]) + (num_insts * INST_WORDS) > num_words_)
+                || (strings_end > len)
+                || (uint64_t(words_[H_DESCRIPTION]) + words_[H_DESCRIPTION_LEN]
+                    > words_[H_STRINGS_LEN]))
+            {
+                fail("table out of bounds");
+            }
+            for (uint32_t i = 0; i < num_insts; ++i)
+            {
+                if (uint64_t(inst_(i)[I_NAME]) + inst_(i)[I_NAME_LEN] > words_[H_STRINGS_LEN])
+                {
+                    fail("mnemonic out of bounds");
+                }
+            }
+
+            std::vector<bool> visited(num_words_, false);
+            std::vector<uint32_t> pending{words_[H_ROOT]};
+            while (!pending.empty())
+            {
+                const uint32_t ref = pending.back();
+                pending.pop_back();
+                if (!isNode_(ref))
+                {
+                    if ((ref < ILLEGAL) && ((ref & ~RESULT) >= num_insts))
+                    {
+                        fail("instruction index out of range");
+                    }
+                    continue;
+                }
+                if ((ref < HEADER_WORDS) || (ref >= words_[H_INSTS]))
+                {
+                    fail("node offset out of range");
+                }
+                if (visited[ref])
+                {
+                    continue;
+                }
+                visited[ref] = true;
+
+                const uint32_t* node = words_ + ref;
+                const uint64_t avail = words_[H_INSTS] - ref;
+                const auto need = [&](const uint64_t n)
+                {
+                    if (n > avail)
+                    {
+                        fail("node out of bounds");
+                    }
+                };
+                // The writer emits children before their parents; requiring that here also rules
+                // out cycles, which eval_() would never return from
+                const auto child = [&](const uint32_t child_ref)
+                {
+                    if (isNode_(child_ref) && (child_ref >= ref))
+                    {
+                        fail("node refers to itself or a later node");
+                    }
+                    pending.push_back(child_ref);
+                };
+                need(1);
+                switch (node[0])
+                {
+                    case TABLE:
+                        need(4);
+                        if ((node[1] >= 32) || (node[2] > 0xffff))
+                        {
+                            fail("bad table node");
+                        }
+                        need(4 + uint64_t(node[2]) + 1);
+                        std::for_each(node + 3, node + 4 + node[2] + 1, child);
+                        break;
+                    case SWITCH:
+                        need(4);
+                        need(4 + (uint64_t(node[3]) * 2));
+                        child(node[2]);
+                        for (uint32_t i = 0; i < node[3]; ++i)
+                        {
+                            child(node[4 + (i * 2) + 1]);
+                        }
+                        break;
+                    case CASES:
+                        need(3);
+                        need(3 + (uint64_t(node[2]) * 3));
+                        child(node[1]);
+                        for (uint32_t i = 0; i < node[2]; ++i)
+                        {
+                            child(node[3 + (i * 3) + 2]);
+                        }
+                        break;
+                    case RESERVED:
+                        need(5);
+                        need(5 + uint64_t(node[4]));
+                        child(node[3]);
+                        break;
+                    default:
+                        fail("unknown node kind " + std::to_string(node[0]));
+                }
+            }
+        }
+    };
+
+} // namespace mavis
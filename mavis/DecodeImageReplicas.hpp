@@ -0,0 +1,235 @@
+#pragma once
+
+#include "DecodeImage.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief CPU to NUMA node map of the host, read from /sys/devices/system/node. A host
+     * without that information (or a non-NUMA build host) is one node holding every CPU
+     */
+    class NumaTopology
+    {
+      public:
+        NumaTopology()
+        {
+            for (uint32_t node = 0;; ++node)
+            {
+                std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node)
+                                      + "/cpulist");
+                if (!cpulist)
+                {
+                    // Node numbers can have holes (offline nodes); stop after a run of them
+                    if (node >= (node_cpus_.size() + MAX_NODE_GAP))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                node_cpus_.resize(node + 1);
+                std::string list;
+                std::getline(cpulist, list);
+                node_cpus_[node] = parseCpuList(list);
+            }
+            // Drop nodes without CPUs (memory-only nodes); nothing can run there
+            node_cpus_.erase(std::remove_if(node_cpus_.begin(), node_cpus_.end(),
+                                            [](const auto & cpus) { return cpus.empty(); }),
+                             node_cpus_.end());
+            if (node_cpus_.empty())
+            {
+                node_cpus_.emplace_back();
+                for (uint32_t cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency());
+                     ++cpu)
+                {
+                    node_cpus_.back().push_back(cpu);
+                }
+            }
+            for (uint32_t node = 0; node < node_cpus_.size(); ++node)
+            {
+                for (const uint32_t cpu : node_cpus_[node])
+                {
+                    if (cpu >= cpu_nodes_.size())
+                    {
+                        cpu_nodes_.resize(cpu + 1, 0);
+                    }
+                    cpu_nodes_[cpu] = node;
+                }
+            }
+        }
+
+        // Number of nodes with CPUs. Nodes are renumbered densely from 0
+        uint32_t getNumNodes() const { return node_cpus_.size(); }
+
+        const std::vector<uint32_t> & getCpus(const uint32_t node) const
+        {
+            return node_cpus_.at(node);
+        }
+
+        uint32_t getNode(const uint32_t cpu) const
+        {
+            return (cpu < cpu_nodes_.size()) ? cpu_nodes_[cpu] : 0;
+        }
+
+        // Node of the CPU the calling thread is running on
+        uint32_t getCurrentNode() const
+        {
+            const int cpu = ::sched_getcpu();
+            return (cpu < 0) ? 0 : getNode(cpu);
+        }
+
+        /**
+         * \brief Pin the calling thread to the CPUs of a node
+         * \return false if the affinity could not be set
+         */
+        bool bindCurrentThread(const uint32_t node) const
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (const uint32_t cpu : getCpus(node))
+            {
+                CPU_SET(cpu, &cpus);
+            }
+            return ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus) == 0;
+        }
+
+        // Parse a kernel CPU list ("0-3,8,10-11")
+        static std::vector<uint32_t> parseCpuList(const std::string & list)
+        {
+            std::vector<uint32_t> cpus;
+            std::stringstream ss(list);
+            std::string range;
+            while (std::getline(ss, range, ','))
+            {
+                if (range.empty()
+                    || (range.find_first_not_of("0123456789-\n ") != std::string::npos))
+                {
+                    continue;
+                }
+                const size_t dash = range.find('-');
+                const uint32_t first = std::stoul(range.substr(0, dash));
+                const uint32_t last =
+                    (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+                for (uint32_t cpu = first; cpu <= last; ++cpu)
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            return cpus;
+        }
+
+      private:
+        static constexpr uint32_t MAX_NODE_GAP = 8;
+
+        std::vector<std::vector<uint32_t>> node_cpus_;
+        std::vector<uint32_t> cpu_nodes_;
+    };
+
+    /**
+     * \brief One copy of a DecodeImage per NUMA node, so that threads on every socket decode
+     * out of local memory
+     *
+     * Each replica is allocated and filled by a thread bound to the CPUs of its node, so the
+     * kernel's first-touch policy places its pages on that node. Threads then decode through
+     * local() (or forNode() when they know their node), which costs a sched_getcpu() per call;
+     * a thread pinned to one node can hold on to the reference local() returns.
+     *
+     * The image is pointer-free, so a replica is just a copy of its words. On a single-node host
+     * there is one replica, shared by everyone. If a builder thread cannot be bound to its node
+     * (restricted cpuset, offline CPUs), its replica still works but may live on another node;
+     * isPlaced() reports which replicas were built in place.
+     */
+    class DecodeImageReplicas
+    {
+      public:
+        explicit DecodeImageReplicas(const DecodeImage & image,
+                                     const NumaTopology & topology = NumaTopology()) :
+            topology_(topology)
+        {
+            replicas_.resize(topology_.getNumNodes());
+            placed_.assign(replicas_.size(), true);
+            if (replicas_.size() == 1)
+            {
+                replicas_.front() = image;
+                return;
+            }
+
+            // Build each replica from a thread on its node; std::thread gives every replica a
+            // fresh thread so the caller's affinity is left alone
+            std::vector<std::exception_ptr> errors(replicas_.size());
+            std::vector<std::thread> threads;
+            for (uint32_t node = 0; node < replicas_.size(); ++node)
+            {
+                threads.emplace_back(
+                    [this, &image, &errors, node]()
+                    {
+                        try
+                        {
+                            placed_[node] = topology_.bindCurrentThread(node);
+                            const auto words = image.getWords();
+                            std::vector<uint32_t> copy(words.size()); // First touch
+                            std::memcpy(copy.data(), words.data(), words.size_bytes());
+                            replicas_[node] = DecodeImage::fromWords(std::move(copy));
+                        }
+                        catch (...)
+                        {
+                            errors[node] = std::current_exception();
+                        }
+                    });
+            }
+            for (auto & thread : threads)
+            {
+                thread.join();
+            }
+            for (const auto & error : errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        uint32_t getNumReplicas() const { return replicas_.size(); }
+
+        const NumaTopology & getTopology() const { return topology_; }
+
+        const DecodeImage & forNode(const uint32_t node) const { return replicas_.at(node); }
+
+        /**
+         * \brief Whether a node's replica was built by a thread bound to that node (so its pages
+         * are on the node); false if the thread could not be bound
+         */
+        bool isPlaced(const uint32_t node) const { return placed_.at(node) != 0; }
+
+        bool allPlaced() const
+        {
+            return std::find(placed_.begin(), placed_.end(), 0) == placed_.end();
+        }
+
+        // The replica on the node the calling thread is running on
+        const DecodeImage & local() const
+        {
+            return (replicas_.size() == 1) ? replicas_.front()
+                                           : replicas_[topology_.getCurrentNode()];
+        }
+
+      private:
+        const NumaTopology topology_;
+        std::vector<DecodeImage> replicas_;
+        std::vector<uint8_t> placed_; // Not vector<bool>: the builder threads each write one
+    };
+
+} // namespace mavis
@@ -0,0 +1,353 @@
+#pragma once
+
+#include "DecodeImage.hpp"
+#include "DecoderTypes.h"
+#include "IFactory.h"
+#include "ReservedEncodings.hpp"
+
+#include <bit>
+#include <cinttypes>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief Flattens a decode trie into a DecodeImage
+     *
+     * The trie is lowered the same way StaticDecoderWriter lowers it to C++: field and match-list
+     * nodes become TABLE nodes (contiguous field bits) or SWITCH nodes, special cases and
+     * overlays become CASES nodes, and reserved encodings become RESERVED nodes (see
+     * ReservedEncodings::find()).
+     */
+    template <typename InstType, typename AnnotationType> class DecodeImageWriter
+    {
+      public:
+        using NodePtr = typename IFactoryIF<InstType, AnnotationType>::PtrType;
+        using NodeView = typename IFactoryIF<InstType, AnnotationType>::NodeView;
+        using Kind = typename NodeView::Kind;
+
+        /**
+         * \param description Free-form text recorded in the image (e.g. the ISA string)
+         */
+        explicit DecodeImageWriter(const std::string & description) : description_(description)
+        {
+        }
+
+        /**
+         * \brief Build the image words (see DecodeImage::fromWords())
+         */
+        std::vector<uint32_t> build(const NodePtr & root)
+        {
+            words_.assign(DecodeImage::HEADER_WORDS, 0);
+            const uint32_t root_ref = lowerNode_(root, DecodePath());
+
+            std::string strings;
+            const auto add_string = [&strings](const std::string & s)
+            {
+                const uint32_t offset = strings.size();
+                strings += s;
+                return offset;
+            };
+
+            const uint32_t insts = words_.size();
+            for (const auto & inst : insts_)
+            {
+                words_.push_back(add_string(inst.mnemonic));
+                words_.push_back(inst.mnemonic.size());
+                words_.push_back(inst.uid);
+                words_.push_back(inst.example);
+            }
+            const uint32_t description = add_string(description_);
+
+            const uint32_t strings_offset = words_.size();
+            words_.resize(words_.size() + ((strings.size() + 3) / 4), 0);
+            std::memcpy(words_.data() + strings_offset, strings.data(), strings.size());
+
+            words_[DecodeImage::H_MAGIC] = DecodeImage::MAGIC;
+            words_[DecodeImage::H_VERSION] = DecodeImage::VERSION;
+            words_[DecodeImage::H_NUM_WORDS] = words_.size();
+            words_[DecodeImage::H_ROOT] = root_ref;
+            words_[DecodeImage::H_NUM_INSTS] = insts_.size();
+            words_[DecodeImage::H_INSTS] = insts;
+            words_[DecodeImage::H_STRINGS] = strings_offset;
+            words_[DecodeImage::H_STRINGS_LEN] = strings.size();
+            words_[DecodeImage::H_DESCRIPTION] = description;
+            words_[DecodeImage::H_DESCRIPTION_LEN] = description_.size();
+            words_[DecodeImage::H_NUM_NODES] = num_nodes_;
+            return std::move(words_);
+        }
+
+        /**
+         * \brief Write the image (a file suitable for DecodeImage::map())
+         */
+        void write(std::ostream & os, const NodePtr & root)
+        {
+            const std::vector<uint32_t> words = build(root);
+            os.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint32_t));
+        }
+
+      private:
+        struct Inst
+        {
+            std::string mnemonic;
+            InstructionUniqueID uid;
+            uint32_t example;
+        };
+
+        // Contiguous fields up to this wide become TABLE nodes; others become SWITCH nodes
+        static constexpr uint32_t MAX_TABLE_BITS = 10;
+
+        const std::string description_;
+        std::vector<uint32_t> words_;
+        std::vector<Inst> insts_;
+        std::unordered_map<std::string, uint32_t> inst_index_;
+        std::unordered_map<const void*, uint32_t> node_refs_;
+        uint32_t num_nodes_ = 0;
+        std::mt19937_64 rng_{0x6d61766973ull};
+
+        uint32_t result_(const std::string & mnemonic, const InstructionUniqueID uid,
+                         const DecodePath & path)
+        {
+            const auto [itr, inserted] = inst_index_.emplace(mnemonic, insts_.size());
+            if (inserted)
+            {
+                insts_.push_back({mnemonic, uid, static_cast<uint32_t>(path.example())});
+            }
+            return DecodeImage::RESULT | itr->second;
+        }
+
+        uint32_t addNode_(const std::vector<uint32_t> & node)
+        {
+            const uint32_t ref = words_.size();
+            if ((ref & DecodeImage::RESULT) != 0) [[unlikely]]
+            {
+                throw std::length_error("DecodeImageWriter: image too large");
+            }
+            words_.insert(words_.end(), node.begin(), node.end());
+            ++num_nodes_;
+            return ref;
+        }
+
+        uint32_t lowerNode_(const NodePtr & node, const DecodePath & path)
+        {
+            if (node == nullptr)
+            {
+                return DecodeImage::UNKNOWN;
+            }
+            if (const auto itr = node_refs_.find(node.get()); itr != node_refs_.end())
+            {
+                return itr->second;
+            }
+
+            const NodeView view = node->getView();
+            uint32_t ref;
+            switch (view.kind)
+            {
+                case Kind::FIELD:
+                    ref = lowerField_(view, path);
+                    break;
+                case Kind::MATCH_LIST:
+                    ref = lowerMatchList_(view, path);
+                    break;
+                case Kind::MATCH:
+                    ref = addNode_({DecodeImage::SWITCH, static_cast<uint32_t>(view.mask),
+                                    DecodeImage::UNKNOWN, 1, static_cast<uint32_t>(view.value),
+                                    lowerNode_(view.children.front().second,
+                                               path.restrict(view.mask, view.value))});
+                    break;
+                case Kind::SPECIAL_CASE:
+                    ref = lowerSpecialCase_(view, path);
+                    break;
+                default:
+                    throw std::invalid_argument("DecodeImageWriter: unsupported trie node '"
+                                                + node->getName() + "'");
+            }
+            node_refs_.emplace(node.get(), ref);
+            return ref;
+        }
+
+        // Children by field value; the default is also tried when a child does not know the
+        // opcode (IFactoryDenseComposite::getInfo())
+        uint32_t lowerField_(const NodeView & view, const DecodePath & path)
+        {
+            const Opcode fmask = view.field->getShiftedMask();
+            std::map<uint64_t, std::vector<Opcode>> values_by_index;
+            for (const Opcode value : enumerateOpcodeBits(fmask))
+            {
+                values_by_index[view.field->extract(value)].push_back(value);
+            }
+
+            std::map<Opcode, uint32_t> refs;
+            for (const auto & [index, child] : view.children)
+            {
+                const auto itr = values_by_index.find(index);
+                if ((child == nullptr) || (itr == values_by_index.end()))
+                {
+                    continue;
+                }
+                const uint32_t child_ref =
+                    lowerNode_(child, path.restrict(fmask, itr->second.front()));
+                for (const Opcode value : itr->second)
+                {
+                    refs.emplace(value, child_ref);
+                }
+            }
+            return addSelect_(fmask, refs, lowerNode_(view.dflt, path));
+        }
+
+        // The matcher is selected by the bits the matchers look at
+        uint32_t lowerMatchList_(const NodeView & view, const DecodePath & path)
+        {
+            const std::vector<Opcode> select_values = enumerateOpcodeBits(view.mask);
+            std::vector<uint32_t> selected(select_values.size());
+            std::vector<DecodePath> child_paths(view.children.size(), path);
+            for (uint32_t i = 0; i < select_values.size(); ++i)
+            {
+                selected[i] = view.select(select_values[i]);
+                if (selected[i] < view.children.size())
+                {
+                    child_paths[selected[i]].select_mask = view.mask;
+                    child_paths[selected[i]].select_values.push_back(select_values[i]);
+                }
+            }
+
+            std::vector<uint32_t> child_refs;
+            for (uint32_t i = 0; i < view.children.size(); ++i)
+            {
+                const NodePtr & child = view.children[i].second;
+                child_refs.push_back(lowerNode_((child != nullptr) ? child : view.dflt,
+                                                child_paths[i]));
+            }
+
+            std::map<Opcode, uint32_t> refs;
+            for (uint32_t i = 0; i < select_values.size(); ++i)
+            {
+                if ((selected[i] < child_refs.size())
+                    && (child_refs[selected[i]] != DecodeImage::UNKNOWN))
+                {
+                    refs.emplace(select_values[i], child_refs[selected[i]]);
+                }
+            }
+            return addSelect_(view.mask, refs, DecodeImage::UNKNOWN);
+        }
+
+        // A TABLE node if mask is one narrow run of bits, else a SWITCH node
+        uint32_t addSelect_(const Opcode mask, const std::map<Opcode, uint32_t> & refs,
+                            const uint32_t dflt)
+        {
+            const uint32_t shift = (mask == 0) ? 0 : std::countr_zero(mask);
+            const Opcode run = mask >> shift;
+            if (((run & (run + 1)) == 0)
+                && (static_cast<uint32_t>(std::popcount(run)) <= MAX_TABLE_BITS))
+            {
+                std::vector<uint32_t> node{DecodeImage::TABLE, shift, static_cast<uint32_t>(run),
+                                           dflt};
+                node.resize(node.size() + run + 1, DecodeImage::UNKNOWN);
+                for (const auto & [value, ref] : refs)
+                {
+                    node[4 + (value >> shift)] = ref;
+                }
+                return addNode_(node);
+            }
+
+            std::vector<uint32_t> node{DecodeImage::SWITCH, static_cast<uint32_t>(mask), dflt,
+                                       static_cast<uint32_t>(refs.size())};
+            for (const auto & [value, ref] : refs)
+            {
+                node.push_back(value);
+                node.push_back(ref);
+            }
+            return addNode_(node);
+        }
+
+        // First matching case wins; reserved encodings and overlays are resolved in the leaf
+        // (IFactorySpecialCaseComposite::getInfo() and IFactory::getInfo())
+        uint32_t lowerSpecialCase_(const NodeView & view, const DecodePath & path)
+        {
+            std::vector<uint32_t> node{DecodeImage::CASES,
+                                       view.default_case ? lowerLeaf_(*view.default_case, path)
+                                                         : DecodeImage::UNKNOWN,
+                                       static_cast<uint32_t>(view.cases.size())};
+            for (const auto & scase : view.cases)
+            {
+                node.push_back(scase.mask);
+                node.push_back(scase.value);
+                node.push_back(lowerLeaf_(scase, path.restrict(scase.mask, scase.value)));
+            }
+            return addNode_(node);
+        }
+
+        uint32_t lowerLeaf_(const typename NodeView::Case & scase, const DecodePath & path)
+        {
+            const auto leaf = std::dynamic_pointer_cast<IFactory<InstType, AnnotationType>>(
+                mavis::utils::notNull(scase.factory));
+            if (leaf == nullptr) [[unlikely]]
+            {
+                throw std::invalid_argument("DecodeImageWriter: special case '" + scase.mnemonic
+                                            + "' does not lead to a leaf");
+            }
+            const uint32_t base =
+                result_(scase.mnemonic, leaf->getVariantUID(scase.mnemonic), path);
+
+            // Only the first matching overlay is considered, and only if it overlays this
+            // mnemonic
+            uint32_t next = base;
+            const auto & overlays = leaf->getOverlays();
+            if (!overlays.empty())
+            {
+                std::vector<uint32_t> node{DecodeImage::CASES, base,
+                                           static_cast<uint32_t>(overlays.size())};
+                for (const auto & olay : overlays)
+                {
+                    uint32_t olay_ref = base;
+                    if (olay->getBaseMnemonic() == scase.mnemonic)
+                    {
+                        const DecodePath olay_path =
+                            path.restrict(olay->getMatchMask(), olay->getMatchValue());
+                        olay_ref = result_(olay->getMnemonic(), olay->getUID(), olay_path);
+                        if (olay->getExtractor() != nullptr)
+                        {
+                            olay_ref = lowerReserved_(olay->getExtractor(), olay_path, olay_ref);
+                        }
+                    }
+                    node.push_back(olay->getMatchMask());
+                    node.push_back(olay->getMatchValue());
+                    node.push_back(olay_ref);
+                }
+                next = addNode_(node);
+            }
+            return lowerReserved_(scase.extractor, path, next);
+        }
+
+        uint32_t lowerReserved_(const ExtractorIF::PtrType & extractor, const DecodePath & path,
+                                const uint32_t next)
+        {
+            const ReservedEncodings reserved = ReservedEncodings::find(extractor, path, rng_);
+            switch (reserved.kind)
+            {
+                case ReservedEncodings::Kind::NONE:
+                    return next;
+                case ReservedEncodings::Kind::ALL:
+                    return DecodeImage::ILLEGAL;
+                default:
+                    {
+                        std::vector<uint32_t> node{DecodeImage::RESERVED,
+                                                   static_cast<uint32_t>(reserved.mask),
+                                                   reserved.list_bad, next,
+                                                   static_cast<uint32_t>(reserved.values.size())};
+                        node.insert(node.end(), reserved.values.begin(), reserved.values.end());
+                        return addNode_(node);
+                    }
+            }
+        }
+    };
+
+} // namespace mavis
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "DecoderExceptions.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief Recorded instruction mix: how many times each opcode was decoded
+     *
+     * Fill one in from a workload (record() each decoded opcode, or merge() per-thread
+     * profiles), save() it, and on later runs load() it and hand it to
+     * Mavis::applyDecodeProfile() so the decode caches start out holding the workload's hottest
+     * opcodes.
+     *
+     * The file format is one "<opcode in hex> <count>" pair per line; blank lines and lines
+     * starting with '#' are ignored. Opcodes are recorded rather than UIDs because UIDs are not
+     * stable across Mavis configurations, and the caches being warmed are tagged by opcode.
+     */
+    class DecodeProfile
+    {
+      public:
+        using CountList = std::vector<std::pair<Opcode, uint64_t>>;
+
+        DecodeProfile() = default;
+
+        /**
+         * \brief Load a profile written by save()
+         */
+        explicit DecodeProfile(const std::string & fname) { load(fname); }
+
+        void record(const Opcode icode, const uint64_t count = 1) { counts_[icode] += count; }
+
+        void merge(const DecodeProfile & other)
+        {
+            for (const auto & [icode, count] : other.counts_)
+            {
+                counts_[icode] += count;
+            }
+        }
+
+        uint64_t getCount(const Opcode icode) const
+        {
+            const auto itr = counts_.find(icode);
+            return (itr == counts_.end()) ? 0 : itr->second;
+        }
+
+        // Number of distinct opcodes recorded
+        size_t size() const { return counts_.size(); }
+
+        bool empty() const { return counts_.empty(); }
+
+        void clear() { counts_.clear(); }
+
+        /**
+         * \brief The n most frequent opcodes, hottest first (ties broken by opcode, so the order
+         * is deterministic)
+         */
+        CountList getHottest(const size_t n) const
+        {
+            CountList hottest(counts_.begin(), counts_.end());
+            const auto hotter = [](const auto & a, const auto & b)
+            { return (a.second != b.second) ? (a.second > b.second) : (a.first < b.first); };
+            if (n < hottest.size())
+            {
+                std::partial_sort(hottest.begin(), hottest.begin() + n, hottest.end(), hotter);
+                hottest.resize(n);
+            }
+            else
+            {
+                std::sort(hottest.begin(), hottest.end(), hotter);
+            }
+            return hottest;
+        }
+
+        /**
+         * \brief Write the profile, hottest opcode first
+         */
+        void save(std::ostream & os) const
+        {
+            std::ios_base::fmtflags os_state(os.flags());
+            os << "# mavis decode profile: <opcode> <count>" << std::endl;
+            for (const auto & [icode, count] : getHottest(counts_.size()))
+            {
+                os << "0x" << std::hex << std::setw(8) << std::setfill('0') << icode << " "
+                   << std::dec << count << std::endl;
+            }
+            os.flags(os_state);
+        }
+
+        void save(const std::string & fname) const
+        {
+            std::ofstream os(fname);
+            if (!os)
+            {
+                throw BadDecodeProfile(fname, "cannot open for writing");
+            }
+            save(os);
+        }
+
+        /**
+         * \brief Add the counts in a profile written by save()
+         */
+        void load(std::istream & is, const std::string & fname = "<stream>")
+        {
+            std::string line;
+            uint32_t line_num = 0;
+            while (std::getline(is, line))
+            {
+                ++line_num;
+                const size_t start = line.find_first_not_of(" \t\r");
+                if ((start == std::string::npos) || (line[start] == '#'))
+                {
+                    continue;
+                }
+                std::istringstream ss(line);
+                std::string icode_str;
+                uint64_t count = 0;
+                if (!(ss >> icode_str >> count))
+                {
+                    throw BadDecodeProfile(fname, "malformed line " + std::to_string(line_num));
+                }
+                try
+                {
+                    record(std::stoull(icode_str, nullptr, 16), count);
+                }
+                catch (const std::logic_error &)
+                {
+                    throw BadDecodeProfile(fname, "bad opcode on line " + std::to_string(line_num));
+                }
+            }
+        }
+
+        void load(const std::string & fname)
+        {
+            std::ifstream is(fname);
+            if (!is)
+            {
+                throw BadDecodeProfile(fname, "cannot open");
+            }
+            load(is, fname);
+        }
+
+      private:
+        std::unordered_map<Opcode, uint64_t> counts_;
+    };
+
+} // namespace mavis
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "ContextRegistry.hpp"
+#include "DecoderExceptions.h"
+#include "DecoderTypes.h"
+
+#include <array>
+#include <cinttypes>
+#include <string>
+#include <utility>
+
+namespace mavis
+{
+
+    /**
+     * \brief A per-hart view of a shared Mavis: decodes in one context of the Mavis's
+     * ContextRegistry, switchable independently of the facade and of every other view
+     *
+     * Mavis::switchContext() changes the context of the whole facade, so a heterogeneous system
+     * model (harts with different extension sets, or in different misa/privilege
+     * configurations) would otherwise need a facade per hart. A view holds only pointers to its
+     * context's decoder state and a small direct-mapped front-end cache of decode results, so
+     * views are cheap to create for every hart, and rebinding one (switchContext()) is O(1):
+     * front-end cache lines are tagged with a binding generation rather than cleared.
+     *
+     * A view refers to the Mavis's ContextRegistry, so it must not outlive the Mavis or be used
+     * after the Mavis is moved. Views of the same context share that context's decode trie and
+     * DTable caches, which (like the facade itself) are not thread safe; harts modeled on
+     * different threads need contexts (or facades) of their own.
+     *
+     * \tparam FrontEndSize Number of front-end cache lines (per view)
+     */
+    template <typename InstType, typename AnnotationType, typename InstTypeAllocator,
+              typename AnnotationTypeAllocator, uint32_t FrontEndSize = 64>
+    class DecodeView
+    {
+      public:
+        using ContextRegistryType =
+            ContextRegistry<InstType, AnnotationType, AnnotationTypeAllocator>;
+        using Context = typename ContextRegistryType::Context;
+        using DecodeInfo = typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo;
+        using DecodeInfoType = typename DecodeInfo::PtrType;
+
+        DecodeView(const ContextRegistryType & registry, const std::string & context_name,
+                   const InstTypeAllocator & inst_allocator) :
+            registry_(&registry),
+            inst_allocator_(inst_allocator)
+        {
+            switchContext(context_name);
+        }
+
+        /**
+         * \brief Rebind to another context of the registry, by name
+         * \throws UnknownContext
+         */
+        void switchContext(const std::string & context_name)
+        {
+            switchContext(registry_->getContext(context_name));
+        }
+
+        /**
+         * \brief Rebind to a context already looked up (ContextRegistry::getContext()); O(1)
+         */
+        void switchContext(const Context & context)
+        {
+            context_ = &context;
+            ++generation_;
+        }
+
+        const Context & getContext() const { return *context_; }
+
+        template <typename... ArgTypes>
+        typename InstType::PtrType makeInst(const Opcode icode, ArgTypes &&... args)
+        {
+            return context_->dtrie->makeInst(icode, inst_allocator_,
+                                             std::forward<ArgTypes>(args)...);
+        }
+
+        DecodeInfoType getInfo(const Opcode icode) { return frontEnd_(icode).info; }
+
+        /**
+         * \brief All of the InstMetaData::InstructionTypes bits of an opcode
+         */
+        std::underlying_type_t<InstMetaData::InstructionTypes>
+        getOpcodeInstTypes(const Opcode icode)
+        {
+            return frontEnd_(icode).inst_types;
+        }
+
+        bool isOpcodeInstType(const Opcode icode, const InstMetaData::InstructionTypes itype)
+        {
+            const auto bits =
+                static_cast<std::underlying_type_t<InstMetaData::InstructionTypes>>(itype);
+            return (getOpcodeInstTypes(icode) & bits) == bits;
+        }
+
+        CompactInst decodeCompact(const Opcode icode)
+        {
+            return context_->dtrie->decodeCompact(icode);
+        }
+
+        VectorInst decodeVector(const Opcode icode, const uint64_t vtype)
+        {
+            return context_->dtrie->decodeVector(icode, vtype);
+        }
+
+        InstructionUniqueID lookupInstructionUniqueID(const std::string & mnemonic) const
+        {
+            return context_->builder->findInstructionUID(mnemonic);
+        }
+
+        const std::string & lookupInstructionMnemonic(const InstructionUniqueID uid) const
+        {
+            return context_->builder->findInstructionMnemonic(uid);
+        }
+
+        // Drop this view's front-end cache (the context's own caches are left alone)
+        void flushCaches() { ++generation_; }
+
+      private:
+        struct Line
+        {
+            Opcode tag = 0;
+            uint64_t generation = 0; // Valid only if equal to the view's generation_
+            DecodeInfoType info;
+            std::underlying_type_t<InstMetaData::InstructionTypes> inst_types = 0;
+        };
+
+        const ContextRegistryType* registry_;
+        const Context* context_ = nullptr;
+        InstTypeAllocator inst_allocator_;
+        uint64_t generation_ = 0;
+        std::array<Line, FrontEndSize> front_end_;
+
+        const Line & frontEnd_(const Opcode icode)
+        {
+            Line & line = front_end_[icode % FrontEndSize];
+            if ((line.generation != generation_) || (line.tag != icode))
+            {
+                line.info = context_->dtrie->getInfo(icode);
+                line.inst_types = line.info->opinfo->getInstType();
+                line.tag = icode;
+                line.generation = generation_;
+            }
+            return line;
+        }
+    };
+
+} // namespace mavis
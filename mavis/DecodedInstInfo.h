@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <bitset>
 #include <vector>
 #include <iostream>
@@ -12,11 +15,11 @@
 namespace mavis
 {
 
-    // TODO: Flesh out the rest of the operand type bit sets
-    struct DecodedInstructionInfo
+    // Cache line aligned so that the hot fields (see below) share a single line
+    struct alignas(64) DecodedInstructionInfo : public RefCounted
     {
       public:
-        typedef std::shared_ptr<DecodedInstructionInfo> PtrType;
+        typedef SharedPtr<DecodedInstructionInfo> PtrType;
         typedef std::bitset<64> BitMask;
         // typedef std::vector<uint8_t>                    OperandArray;
         using OperandArray = ExtractorIF::RegListType;
@@ -86,34 +89,6 @@ namespace mavis
             return result;
         }
 
-        // TEMPORARY: check reglist against bitset for sanity
-        // static inline bool
-        // agree_(const OperandArray &arr, uint64_t bits, const std::string &context, const
-        // std::string &form_name)
-        //{
-        //    uint64_t arr_bits = 0;
-        //    for (const auto &reg : arr) {
-        //        arr_bits |= (0x1ull << reg);
-        //    }
-        //    if (arr_bits != bits) {
-        //        std::cerr << "EXTRACTION MISMATCH: Form '" << form_name << "'"
-        //                  << ", context '" << context << "'"
-        //                  << ", array [";
-        //        for (const auto &reg : arr) {
-        //            std::cerr << std::dec << reg << ",";
-        //        }
-        //        std::cerr << "], (0x" << std::hex << arr_bits << ")"
-        //                  << ", bitset=0x" << bits << " [";
-        //        OperandArray bits_arr = getVectorOfBitIndices_(bits);
-        //        for (const auto &reg : bits_arr) {
-        //            std::cerr << std::dec << reg << ",";
-        //        }
-        //        std::cerr << "]" << std::dec << std::endl;
-        //        return false;
-        //    }
-        //    return true;
-        //}
-
         // TEMPORARY: Check opinfo lists for agreement with reg lists and bit sets
         static void
         agree_opinfo_(const OperandInfo::ElementList & olist, uint64_t bits,
@@ -122,8 +97,9 @@ namespace mavis
         {
             if (olist.empty() && (bits != 0)) [[unlikely]]
             {
-                throw OperandListExtractionMismatch(form_name, context, bits,
-                                                    getVectorOfBitIndices_(bits));
+                const OperandArray bits_arr = getVectorOfBitIndices_(bits);
+                throw OperandListExtractionMismatch(
+                    form_name, context, bits, std::vector<uint32_t>(bits_arr.begin(), bits_arr.end()));
             }
 
             for (const auto & opinfo : olist)
@@ -133,444 +109,202 @@ namespace mavis
                 if (((otype == InstMetaData::OperandTypes::NONE) || (opinfo.operand_type == otype))
                     && ((oi_bit & bits) == 0)) [[unlikely]]
                 {
+                    const OperandArray bits_arr = getVectorOfBitIndices_(bits);
                     throw OperandListExtractionMismatch(
-                        form_name, context, bits, opinfo.field_value, getVectorOfBitIndices_(bits));
+                        form_name, context, bits, opinfo.field_value,
+                        std::vector<uint32_t>(bits_arr.begin(), bits_arr.end()));
                 }
             }
         }
 
+        static constexpr uint32_t N_OPER_TYPES =
+            static_cast<std::underlying_type_t<InstMetaData::OperandTypes>>(
+                InstMetaData::OperandTypes::__N);
+
+        static constexpr uint32_t operTypeIndex_(InstMetaData::OperandTypes otype)
+        {
+            return static_cast<std::underlying_type_t<InstMetaData::OperandTypes>>(otype);
+        }
+
+        // Everything filled in by ExtractorIF::extractAll() is extracted by the constructor;
+        // the rest of the fields are extracted together, on first access to any of them
+        const ExtractorIF::ExtractedFields & fields_() const { return extracted_; }
+
+        uint64_t sourceTypeRegs_(InstMetaData::OperandTypes otype) const
+        {
+            return cold_().type_sources[operTypeIndex_(otype)];
+        }
+
+        uint64_t destTypeRegs_(InstMetaData::OperandTypes otype) const
+        {
+            return cold_().type_dests[operTypeIndex_(otype)];
+        }
+
+        uint8_t computeExtInstType_() const
+        {
+            return computeExtInstType(meta_, getSourceRegs(), getDestRegs());
+        }
+
+        // Check the operand info lists against the register bit sets
+        void sanityCheck_() const
+        {
+            const std::string & form_name = extractor_->getName();
+            const auto & source_list = getSourceOpInfoList();
+            const auto & dest_list = getDestOpInfoList();
+
+            // The single pass extraction must agree with the individual extractor methods
+            ExtractorIF::ExtractedFields reference;
+            extractor_->ExtractorIF::extractAll(icode_, meta_, reference);
+            const auto & fields = fields_();
+            if ((fields.sources != reference.sources) || (fields.dests != reference.dests)
+                || (fields.immediate_type != reference.immediate_type)
+                || (fields.immediate != reference.immediate)
+                || (fields.signed_offset != reference.signed_offset)
+                || (fields.is_hint != reference.is_hint)
+                || (fields.source_opinfo.getElements() != reference.source_opinfo.getElements())
+                || (fields.dest_opinfo.getElements() != reference.dest_opinfo.getElements()))
+                [[unlikely]]
+            {
+                throw std::logic_error("extractAll() for form '" + form_name + "' of '" + mnemonic
+                                       + "' disagrees with the individual extractor methods");
+            }
+
+            agree_opinfo_(source_list, getSourceRegs(), "sources", form_name);
+            agree_opinfo_(dest_list, getDestRegs(), "dests", form_name);
+
+            static const std::array<std::pair<InstMetaData::OperandTypes, const char*>,
+                                    N_OPER_TYPES>
+                type_names = {{{InstMetaData::OperandTypes::WORD, "word"},
+                               {InstMetaData::OperandTypes::LONG, "long"},
+                               {InstMetaData::OperandTypes::HALF, "half"},
+                               {InstMetaData::OperandTypes::SINGLE, "single"},
+                               {InstMetaData::OperandTypes::DOUBLE, "double"},
+                               {InstMetaData::OperandTypes::QUAD, "quad"},
+                               {InstMetaData::OperandTypes::VECTOR, "vector"}}};
+            for (const auto & [otype, name] : type_names)
+            {
+                agree_opinfo_(source_list, sourceTypeRegs_(otype), std::string(name) + "_sources",
+                              form_name, otype);
+                agree_opinfo_(dest_list, destTypeRegs_(otype), std::string(name) + "_dests",
+                              form_name, otype);
+            }
+        }
+
+        // Fields that are rarely read (or only by disassembly/debug code) live out of line and
+        // are only allocated when one of them is first needed
+        struct ColdFields
+        {
+            std::array<uint64_t, N_OPER_TYPES> type_sources{};
+            std::array<uint64_t, N_OPER_TYPES> type_dests{};
+            uint64_t addr_sources = 0;
+            uint64_t data_sources = 0;
+            Float16 half_float_immediate;
+            Float32 single_float_immediate;
+            Float64 double_float_immediate;
+            Float128 quad_float_immediate;
+            InstMetaData::SpecialFieldsMap special_fields;
+        };
+
+        // The cold fields are filled in once, under cold_once_, so that instructions sharing
+        // this object can read them from several threads
+        const ColdFields & cold_() const
+        {
+            std::call_once(cold_once_,
+                           [this]()
+                           {
+                               std::unique_ptr<ColdFields> cold(new ColdFields());
+                               for (uint32_t idx = 0; idx < N_OPER_TYPES; ++idx)
+                               {
+                                   const auto otype = static_cast<InstMetaData::OperandTypes>(idx);
+                                   cold->type_sources[idx] =
+                                       extractor_->getSourceOperTypeRegs(icode_, meta_, otype);
+                                   cold->type_dests[idx] =
+                                       extractor_->getDestOperTypeRegs(icode_, meta_, otype);
+                               }
+                               cold->addr_sources = extractor_->getSourceAddressRegs(icode_);
+                               cold->data_sources = extractor_->getSourceDataRegs(icode_);
+                               cold->half_float_immediate =
+                                   extractor_->getHalfFloatImmediate(icode_);
+                               cold->single_float_immediate =
+                                   extractor_->getSingleFloatImmediate(icode_);
+                               cold->double_float_immediate =
+                                   extractor_->getDoubleFloatImmediate(icode_);
+                               cold->quad_float_immediate =
+                                   extractor_->getQuadFloatImmediate(icode_);
+                               cold->special_fields = extractor_->getSpecialFields(icode_, meta_);
+                               cold_fields_ = std::move(cold);
+                           });
+            return *cold_fields_;
+        }
+
+        // The fields read for every instruction (register masks, immediate, UID) are packed into
+        // the first cache line: ExtractedFields leads with the masks and immediates. Don't
+        // reorder these without checking sizeof/offsets. They are all set by the constructor
+        const Opcode icode_;
+        uint8_t ext_itype_ =
+            static_cast<std::underlying_type_t<ExtractedInstTypes>>(ExtractedInstTypes::NONE);
+        ExtractorIF::ExtractedFields extracted_;
+
       public:
         // Architectural information
-        const std::string mnemonic;
         const InstructionUniqueID unique_id;
+        const std::string mnemonic;
 
-        const OperandInfo source_opinfo;
-        const OperandInfo dest_opinfo;
-
-        const OperandInfo::ElementList source_opinfo_list;
-        const OperandInfo::ElementList dest_opinfo_list;
-
-        const uint64_t sources;
-        // const OperandArray source_vals;
-        const uint32_t n_sources;
-
-        const uint64_t dests;
-        // const OperandArray dest_vals;
-        const uint32_t n_dests;
-
-        const uint64_t word_sources;
-        const uint64_t word_dests;
-        const uint64_t word_operands;
-        // const OperandArray word_oper_vals;
-        // const OperandArray word_source_vals;
-        // const OperandArray word_dest_vals;
-        const uint32_t word_n_sources;
-        const uint32_t word_n_dests;
-        const uint32_t word_n_operands;
-
-        const uint64_t long_sources;
-        const uint64_t long_dests;
-        const uint64_t long_operands;
-        // const OperandArray long_oper_vals;
-        // const OperandArray long_source_vals;
-        // const OperandArray long_dest_vals;
-        const uint32_t long_n_sources;
-        const uint32_t long_n_dests;
-        const uint32_t long_n_operands;
-
-        const uint64_t int_sources;
-        const uint64_t int_dests;
-        const uint64_t int_operands;
-        // const OperandArray int_oper_vals;
-        // const OperandArray int_source_vals;
-        // const OperandArray int_dest_vals;
-        const uint32_t int_n_sources;
-        const uint32_t int_n_dests;
-        const uint32_t int_n_operands;
-
-        const uint64_t half_sources;
-        const uint64_t half_dests;
-        const uint64_t half_operands;
-        // const OperandArray half_oper_vals;
-        // const OperandArray half_source_vals;
-        // const OperandArray half_dest_vals;
-        const uint32_t half_n_sources;
-        const uint32_t half_n_dests;
-        const uint32_t half_n_operands;
-
-        const uint64_t single_sources;
-        const uint64_t single_dests;
-        const uint64_t single_operands;
-        // const OperandArray single_oper_vals;
-        // const OperandArray single_source_vals;
-        // const OperandArray single_dest_vals;
-        const uint32_t single_n_sources;
-        const uint32_t single_n_dests;
-        const uint32_t single_n_operands;
-
-        const uint64_t double_sources;
-        const uint64_t double_dests;
-        const uint64_t double_operands;
-        // const OperandArray double_oper_vals;
-        // const OperandArray double_source_vals;
-        // const OperandArray double_dest_vals;
-        const uint32_t double_n_sources;
-        const uint32_t double_n_dests;
-        const uint32_t double_n_operands;
-
-        const uint64_t float_sources;
-        const uint64_t float_dests;
-        const uint64_t float_operands;
-        // const OperandArray float_oper_vals;
-        // const OperandArray float_source_vals;
-        // const OperandArray float_dest_vals;
-        const uint32_t float_n_sources;
-        const uint32_t float_n_dests;
-        const uint32_t float_n_operands;
-
-        const uint64_t quad_sources;
-        const uint64_t quad_dests;
-        const uint64_t quad_operands;
-        // const OperandArray quad_oper_vals;
-        // const OperandArray quad_source_vals;
-        // const OperandArray quad_dest_vals;
-        const uint32_t quad_n_sources;
-        const uint32_t quad_n_dests;
-        const uint32_t quad_n_operands;
-
-        const uint64_t vector_sources;
-        const uint64_t vector_dests;
-        const uint64_t vector_operands;
-        const uint32_t vector_n_sources;
-        const uint32_t vector_n_dests;
-        const uint32_t vector_n_operands;
-
-        const uint64_t addr_sources;
-        // const OperandArray addr_source_vals;
-        // const uint32_t addr_n_sources;
-
-        const uint64_t data_sources;
-        // const OperandArray data_source_vals;
-        // const uint32_t data_n_sources;
-
-        const bool is_hint;
-        const ImmediateType immediate_type;
-        const bool has_immediate;
-        const uint64_t immediate;
-        const int64_t signed_offset;
-        const Float16 half_float_immediate;
-        const Float32 single_float_immediate;
-        const Float64 double_float_immediate;
-        const Float128 quad_float_immediate;
-        const uint32_t data_size;
-        // const uint64_t function;
-        uint64_t ext_itype =
-            static_cast<std::underlying_type_t<ExtractedInstTypes>>(ExtractedInstTypes::NONE);
+      private:
+        // Where the lazily extracted fields come from
+        const ExtractorIF::PtrType extractor_;
+        const InstMetaData::PtrType meta_;
+
+        mutable std::once_flag cold_once_;
+        mutable std::unique_ptr<ColdFields> cold_fields_;
 
-        // special fields
-        InstMetaData::SpecialFieldsMap special_fields;
+      public:
 
+        /**
+         * \brief The register masks, operand lists, immediates and extracted instruction types
+         * are extracted here; the rarely read fields (per operand type masks, address/data
+         * registers, float immediates, special fields) on first access to any of them. The
+         * object is immutable once shared: reading it from several threads is safe
+         */
         DecodedInstructionInfo(const std::string & iname, const InstructionUniqueID uid,
                                const ExtractorIF::PtrType & extractor,
                                const InstMetaData::PtrType & meta, const Opcode icode) :
-            mnemonic(iname),
+            icode_(icode),
             unique_id(uid),
-
-            source_opinfo(extractor->getSourceOperandInfo(icode, meta)),
-            dest_opinfo(extractor->getDestOperandInfo(icode, meta)),
-
-            source_opinfo_list(source_opinfo.getElements()),
-            dest_opinfo_list(dest_opinfo.getElements()),
-
-            sources(extractor->getSourceRegs(icode)),
-            // source_vals(extractor->getSourceList(icode)),
-            n_sources(source_opinfo.getNOpers()),
-
-            dests(extractor->getDestRegs(icode)),
-            // dest_vals(extractor->getDestList(icode)),
-            n_dests(dest_opinfo.getNOpers()),
-
-            word_sources(
-                extractor->getSourceOperTypeRegs(icode, meta, InstMetaData::OperandTypes::WORD)),
-            word_dests(
-                extractor->getDestOperTypeRegs(icode, meta, InstMetaData::OperandTypes::WORD)),
-            word_operands(word_sources | word_dests),
-            // word_oper_vals(extractor->getOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::WORD)),
-            // word_source_vals(extractor->getSourceOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::WORD)),
-            // word_dest_vals(extractor->getDestOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::WORD)),
-            word_n_sources(source_opinfo.getNTypes(InstMetaData::OperandTypes::WORD)),
-            word_n_dests(dest_opinfo.getNTypes(InstMetaData::OperandTypes::WORD)),
-            word_n_operands(word_n_sources + word_n_dests),
-
-            long_sources(
-                extractor->getSourceOperTypeRegs(icode, meta, InstMetaData::OperandTypes::LONG)),
-            long_dests(
-                extractor->getDestOperTypeRegs(icode, meta, InstMetaData::OperandTypes::LONG)),
-            long_operands(long_sources | long_dests),
-            // long_oper_vals(extractor->getOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::LONG)),
-            // long_source_vals(extractor->getSourceOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::LONG)),
-            // long_dest_vals(extractor->getDestOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::LONG)),
-            long_n_sources(source_opinfo.getNTypes(InstMetaData::OperandTypes::LONG)),
-            long_n_dests(dest_opinfo.getNTypes(InstMetaData::OperandTypes::LONG)),
-            long_n_operands(long_n_sources + long_n_dests),
-
-            int_sources(word_sources | long_sources),
-            int_dests(word_dests | long_dests),
-            int_operands(int_sources | int_dests),
-            // int_oper_vals(combineVals_(word_oper_vals, long_oper_vals)),
-            // int_source_vals(combineVals_(word_source_vals, long_source_vals)),
-            // int_dest_vals(combineVals_(word_dest_vals, long_dest_vals)),
-            int_n_sources(word_n_sources + long_n_sources),
-            int_n_dests(word_n_dests + long_n_dests),
-            int_n_operands(int_n_sources + int_n_dests),
-
-            half_sources(
-                extractor->getSourceOperTypeRegs(icode, meta, InstMetaData::OperandTypes::HALF)),
-            half_dests(
-                extractor->getDestOperTypeRegs(icode, meta, InstMetaData::OperandTypes::HALF)),
-            half_operands(half_sources | half_dests),
-            // half_oper_vals(extractor->getOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::HALF)),
-            // half_source_vals(extractor->getSourceOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::HALF)),
-            // half_dest_vals(extractor->getDestOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::HALF)),
-            half_n_sources(source_opinfo.getNTypes(InstMetaData::OperandTypes::HALF)),
-            half_n_dests(dest_opinfo.getNTypes(InstMetaData::OperandTypes::HALF)),
-            half_n_operands(half_n_sources + half_n_dests),
-
-            single_sources(
-                extractor->getSourceOperTypeRegs(icode, meta, InstMetaData::OperandTypes::SINGLE)),
-            single_dests(
-                extractor->getDestOperTypeRegs(icode, meta, InstMetaData::OperandTypes::SINGLE)),
-            single_operands(single_sources | single_dests),
-            // single_oper_vals(extractor->getOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::SINGLE)),
-            // single_source_vals(extractor->getSourceOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::SINGLE)),
-            // single_dest_vals(extractor->getDestOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::SINGLE)),
-            single_n_sources(source_opinfo.getNTypes(InstMetaData::OperandTypes::SINGLE)),
-            single_n_dests(dest_opinfo.getNTypes(InstMetaData::OperandTypes::SINGLE)),
-            single_n_operands(single_n_sources + single_n_dests),
-
-            double_sources(
-                extractor->getSourceOperTypeRegs(icode, meta, InstMetaData::OperandTypes::DOUBLE)),
-            double_dests(
-                extractor->getDestOperTypeRegs(icode, meta, InstMetaData::OperandTypes::DOUBLE)),
-            double_operands(double_sources | double_dests),
-            // double_oper_vals(extractor->getOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::DOUBLE)),
-            // double_source_vals(extractor->getSourceOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::DOUBLE)),
-            // double_dest_vals(extractor->getDestOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::DOUBLE)),
-            double_n_sources(source_opinfo.getNTypes(InstMetaData::OperandTypes::DOUBLE)),
-            double_n_dests(dest_opinfo.getNTypes(InstMetaData::OperandTypes::DOUBLE)),
-            double_n_operands(double_n_sources + double_n_dests),
-
-            float_sources(half_sources | single_sources | double_sources),
-            float_dests(half_dests | single_dests | double_dests),
-            float_operands(float_sources | float_dests),
-            // float_oper_vals(combineVals_(single_oper_vals, double_oper_vals)),
-            // float_source_vals(combineVals_(single_source_vals, double_source_vals)),
-            // float_dest_vals(combineVals_(single_dest_vals, double_dest_vals)),
-            float_n_sources(half_n_sources + single_n_sources + double_n_sources),
-            float_n_dests(half_n_dests + single_n_dests + double_n_dests),
-            float_n_operands(float_n_sources + float_n_dests),
-
-            quad_sources(
-                extractor->getSourceOperTypeRegs(icode, meta, InstMetaData::OperandTypes::QUAD)),
-            quad_dests(
-                extractor->getDestOperTypeRegs(icode, meta, InstMetaData::OperandTypes::QUAD)),
-            quad_operands(quad_sources | quad_dests),
-            // quad_oper_vals(extractor->getOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::QUAD)),
-            // quad_source_vals(extractor->getSourceOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::QUAD)),
-            // quad_dest_vals(extractor->getDestOperTypeList(icode, meta,
-            // InstMetaData::OperandTypes::QUAD)),
-            quad_n_sources(source_opinfo.getNTypes(InstMetaData::OperandTypes::QUAD)),
-            quad_n_dests(dest_opinfo.getNTypes(InstMetaData::OperandTypes::QUAD)),
-            quad_n_operands(quad_n_sources + quad_n_dests),
-
-            vector_sources(
-                extractor->getSourceOperTypeRegs(icode, meta, InstMetaData::OperandTypes::VECTOR)),
-            vector_dests(
-                extractor->getDestOperTypeRegs(icode, meta, InstMetaData::OperandTypes::VECTOR)),
-            vector_operands(vector_sources | vector_dests),
-            vector_n_sources(source_opinfo.getNTypes(InstMetaData::OperandTypes::VECTOR)),
-            vector_n_dests(dest_opinfo.getNTypes(InstMetaData::OperandTypes::VECTOR)),
-            vector_n_operands(vector_n_sources + vector_n_dests),
-
-            addr_sources(extractor->getSourceAddressRegs(icode)),
-            // addr_source_vals(extractor->getSourceAddressList(icode)),
-            // addr_n_sources(addr_source_vals.size()),
-
-            data_sources(extractor->getSourceDataRegs(icode)),
-            // data_source_vals(extractor->getSourceDataList(icode)),
-            // data_n_sources(data_source_vals.size()),
-
-            is_hint(extractor->isHint(icode)),
-            immediate_type(extractor->getImmediateType()),
-            has_immediate(extractor->hasImmediate()),
-            immediate(extractor->getImmediate(icode)),
-            signed_offset(extractor->getSignedOffset(icode)),
-            half_float_immediate(extractor->getHalfFloatImmediate(icode)),
-            single_float_immediate(extractor->getSingleFloatImmediate(icode)),
-            double_float_immediate(extractor->getDoubleFloatImmediate(icode)),
-            quad_float_immediate(extractor->getQuadFloatImmediate(icode)),
-            data_size(meta->getDataSize()),
-            special_fields(extractor->getSpecialFields(icode, meta))
-        // function(extractor->getFunction(icode))
+            mnemonic(iname),
+            extractor_(extractor),
+            meta_(meta)
         {
+            extractor_->extractAll(icode_, meta_, extracted_);
+            ext_itype_ = computeExtInstType_();
 #ifndef NDEBUG
-            // TODO: Move this into a sanity checking method
             // FOR NOW: We bypass these checks if we're given an pseudo op (opcode = 0, e.g. from
             // makeInstDirectly() et al)
             if (icode != 0)
             {
-                const std::string & form_name = extractor->getName();
-
-                // OperandArray    x_arr = extractor->getSourceList(icode);
-                // assert(agree_(x_arr, sources, "sources", form_name));
-
-                // x_arr = extractor->getSourceAddressList(icode);
-                // assert(agree_(x_arr, addr_sources, "addr_sources", form_name));
-
-                // x_arr = extractor->getSourceDataList(icode);
-                // assert(agree_(x_arr, data_sources, "data_sources", form_name));
-
-                // x_arr = extractor->getDestList(icode);
-                // assert(agree_(x_arr, dests, "dests", form_name));
-
-                // for (uint32_t i = 0;
-                //      i <
-                //      static_cast<std::underlying_type_t<InstMetaData::OperandTypes>>(InstMetaData::OperandTypes::__N);
-                //      ++i) {
-                //     auto kind = static_cast<InstMetaData::OperandTypes>(i);
-                //
-                //     x_arr = extractor->getSourceOperTypeList(icode, meta, kind);
-                //     uint64_t bits = extractor->getSourceOperTypeRegs(icode, meta, kind);
-                //     assert(agree_(x_arr, bits, "source_opertypes", form_name));
-                //
-                //     x_arr = extractor->getDestOperTypeList(icode, meta, kind);
-                //     bits = extractor->getDestOperTypeRegs(icode, meta, kind);
-                //     assert(agree_(x_arr, bits, "dest_opertypes", form_name));
-                // }
-
-                // assert(agree_(word_oper_vals, word_operands, "word_operands", form_name));
-                // assert(agree_(word_source_vals, word_sources, "word_sources", form_name));
-                // assert(agree_(word_dest_vals, word_dests, "word_dests", form_name));
-
-                // assert(agree_(long_oper_vals, long_operands, "long_operands", form_name));
-                // assert(agree_(long_source_vals, long_sources, "long_sources", form_name));
-                // assert(agree_(long_dest_vals, long_dests, "long_dests", form_name));
-
-                // assert(agree_(int_oper_vals, int_operands, "int_operands", form_name));
-                // assert(agree_(int_source_vals, int_sources, "int_sources", form_name));
-                // assert(agree_(int_dest_vals, int_dests, "int_dests", form_name));
-
-                // assert(agree_(single_oper_vals, single_operands, "single_operands", form_name));
-                // assert(agree_(single_source_vals, single_sources, "single_sources", form_name));
-                // assert(agree_(single_dest_vals, single_dests, "single_dests", form_name));
-
-                // assert(agree_(double_oper_vals, double_operands, "double_operands", form_name));
-                // assert(agree_(double_source_vals, double_sources, "double_sources", form_name));
-                // assert(agree_(double_dest_vals, double_dests, "double_dests", form_name));
-
-                // assert(agree_(float_oper_vals, float_operands, "float_operands", form_name));
-                // assert(agree_(float_source_vals, float_sources, "float_sources", form_name));
-                // assert(agree_(float_dest_vals, float_dests, "float_dests", form_name));
-
-                // assert(agree_(quad_oper_vals, quad_operands, "quad_operands", form_name));
-                // assert(agree_(quad_source_vals, quad_sources, "quad_sources", form_name));
-                // assert(agree_(quad_dest_vals, quad_dests, "quad_dests", form_name));
-
-                // assert(agree_(addr_source_vals, addr_sources, "addr_sources", form_name));
-                // assert(agree_(data_source_vals, data_sources, "data_sources", form_name));
-
-                agree_opinfo_(source_opinfo_list, sources, "sources", form_name);
-                agree_opinfo_(source_opinfo_list, word_sources, "word_sources", form_name,
-                              InstMetaData::OperandTypes::WORD);
-                agree_opinfo_(source_opinfo_list, long_sources, "long_sources", form_name,
-                              InstMetaData::OperandTypes::LONG);
-                agree_opinfo_(source_opinfo_list, half_sources, "half_sources", form_name,
-                              InstMetaData::OperandTypes::HALF);
-                agree_opinfo_(source_opinfo_list, single_sources, "single_sources", form_name,
-                              InstMetaData::OperandTypes::SINGLE);
-                agree_opinfo_(source_opinfo_list, double_sources, "double_sources", form_name,
-                              InstMetaData::OperandTypes::DOUBLE);
-                agree_opinfo_(source_opinfo_list, quad_sources, "quad_sources", form_name,
-                              InstMetaData::OperandTypes::QUAD);
-                agree_opinfo_(source_opinfo_list, vector_sources, "vector_sources", form_name,
-                              InstMetaData::OperandTypes::VECTOR);
-
-                agree_opinfo_(dest_opinfo_list, dests, "dests", form_name);
-                agree_opinfo_(dest_opinfo_list, word_dests, "word_dests", form_name,
-                              InstMetaData::OperandTypes::WORD);
-                agree_opinfo_(dest_opinfo_list, long_dests, "long_dests", form_name,
-                              InstMetaData::OperandTypes::LONG);
-                agree_opinfo_(dest_opinfo_list, half_dests, "half_dests", form_name,
-                              InstMetaData::OperandTypes::HALF);
-                agree_opinfo_(dest_opinfo_list, single_dests, "single_dests", form_name,
-                              InstMetaData::OperandTypes::SINGLE);
-                agree_opinfo_(dest_opinfo_list, double_dests, "double_dests", form_name,
-                              InstMetaData::OperandTypes::DOUBLE);
-                agree_opinfo_(dest_opinfo_list, quad_dests, "quad_dests", form_name,
-                              InstMetaData::OperandTypes::QUAD);
-                agree_opinfo_(dest_opinfo_list, vector_dests, "vector_dests", form_name,
-                              InstMetaData::OperandTypes::VECTOR);
+                sanityCheck_();
             }
-#else
-            // When I moved the above calls to agree_opinfo_ behind the NDEBUG ifdef guard,
-            // I noticed that the perf_test performance actually got *worse*.
-            //
-            // After some trial and error, I discovered that prefetching the following members
-            // recovers the performance loss, and gains an additional ~2%.
-            //
-            // Here are some thoughts on why this (appears to) work:
-            // 1. sizeof(DecodedInstructionInfo) is over 2kB
-            // 2. We do *a lot* of work in the initializer list for this class and call several
-            //    external methods
-            // 3. Each one of these members is used in an agree_opinfo_ invocation
-            //
-            // Altogether, these members cover about 7 contiguous cachelines. I haven't been able
-            // to pin down exactly which members/cachelines are the most important.
-            __builtin_prefetch(static_cast<const void*>(&sources));
-            __builtin_prefetch(static_cast<const void*>(&word_sources));
-            __builtin_prefetch(static_cast<const void*>(&long_sources));
-            __builtin_prefetch(static_cast<const void*>(&half_sources));
-            __builtin_prefetch(static_cast<const void*>(&single_sources));
-            __builtin_prefetch(static_cast<const void*>(&double_sources));
-            __builtin_prefetch(static_cast<const void*>(&quad_sources));
-            __builtin_prefetch(static_cast<const void*>(&vector_sources));
-            __builtin_prefetch(static_cast<const void*>(&dests));
-            __builtin_prefetch(static_cast<const void*>(&word_dests));
-            __builtin_prefetch(static_cast<const void*>(&long_dests));
-            __builtin_prefetch(static_cast<const void*>(&half_dests));
-            __builtin_prefetch(static_cast<const void*>(&single_dests));
-            __builtin_prefetch(static_cast<const void*>(&double_dests));
-            __builtin_prefetch(static_cast<const void*>(&quad_dests));
-            __builtin_prefetch(static_cast<const void*>(&vector_dests));
 #endif
+        }
 
-            // Certain instruction type information is most readily available from extracted
-            // data. The extracted type information is used to future qualify extraction-independent
-            // information provided in the meta-data (meta) that is coded in the JSON ISA file
-            // (i.e. via meta->getInstType/isInstType)
+        // Certain instruction type information is most readily available from extracted
+        // data. The extracted type information is used to future qualify extraction-independent
+        // information provided in the meta-data (meta) that is coded in the JSON ISA file
+        // (i.e. via meta->getInstType/isInstType). Static, so that the types of an opcode can be
+        // computed from its extractor's register masks without building the decoded info (see
+        // IFactory::getTypes)
+        static uint8_t computeExtInstType(const InstMetaData::PtrType & meta,
+                                          const uint64_t sources, const uint64_t dests)
+        {
+            uint8_t ext_itype =
+                static_cast<std::underlying_type_t<ExtractedInstTypes>>(ExtractedInstTypes::NONE);
 
             // Here, we qualify JAL and JALR instructions with call/return/indirect type
             // information, based on the source/dest register values
             constexpr uint64_t link_regs = (1ull << REGISTER_LINK) | (1ull << REGISTER_ALT_LINK);
-            if (meta->isInstType(InstMetaData::InstructionTypes::JAL)
-                || meta->isInstType(InstMetaData::InstructionTypes::JALR))
+            if ((meta != nullptr)
+                && (meta->isInstType(InstMetaData::InstructionTypes::JAL)
+                    || meta->isInstType(InstMetaData::InstructionTypes::JALR)))
             {
                 // If the dest reg is one of the link registers, we include the CALL kind
                 if ((dests & link_regs) != 0)
@@ -596,22 +330,189 @@ namespace mavis
                         ExtractedInstTypes::INDIRECT);
                 }
             }
+            return ext_itype;
+        }
+
+        uint64_t getSourceRegs() const { return fields_().sources; }
+
+        uint64_t getDestRegs() const { return fields_().dests; }
+
+        const OperandInfo & getSourceOpInfo() const { return fields_().source_opinfo; }
+
+        const OperandInfo & getDestOpInfo() const { return fields_().dest_opinfo; }
+
+        const OperandInfo::ElementList & getSourceOpInfoList() const
+        {
+            return getSourceOpInfo().getElements();
+        }
+
+        const OperandInfo::ElementList & getDestOpInfoList() const
+        {
+            return getDestOpInfo().getElements();
+        }
+
+        uint32_t numSourceRegs() const { return getSourceOpInfo().getNOpers(); }
+
+        uint32_t numDestRegs() const { return getDestOpInfo().getNOpers(); }
+
+        uint64_t getSourceRegsByType(InstMetaData::OperandTypes otype) const
+        {
+            if (otype == InstMetaData::OperandTypes::__N) [[unlikely]]
+            {
+                throw std::invalid_argument("invalid operand type");
+            }
+            return sourceTypeRegs_(otype);
+        }
+
+        uint64_t getDestRegsByType(InstMetaData::OperandTypes otype) const
+        {
+            if (otype == InstMetaData::OperandTypes::__N) [[unlikely]]
+            {
+                throw std::invalid_argument("invalid operand type");
+            }
+            return destTypeRegs_(otype);
+        }
+
+        uint32_t numSourceRegsByType(InstMetaData::OperandTypes otype) const
+        {
+            if (otype == InstMetaData::OperandTypes::__N) [[unlikely]]
+            {
+                throw std::invalid_argument("invalid operand type");
+            }
+            return getSourceOpInfo().getNTypes(otype);
+        }
+
+        uint32_t numDestRegsByType(InstMetaData::OperandTypes otype) const
+        {
+            if (otype == InstMetaData::OperandTypes::__N) [[unlikely]]
+            {
+                throw std::invalid_argument("invalid operand type");
+            }
+            return getDestOpInfo().getNTypes(otype);
+        }
+
+        uint64_t getIntSourceRegs() const
+        {
+            return sourceTypeRegs_(InstMetaData::OperandTypes::WORD)
+                   | sourceTypeRegs_(InstMetaData::OperandTypes::LONG);
+        }
+
+        uint64_t getIntDestRegs() const
+        {
+            return destTypeRegs_(InstMetaData::OperandTypes::WORD)
+                   | destTypeRegs_(InstMetaData::OperandTypes::LONG);
+        }
+
+        uint64_t getFloatSourceRegs() const
+        {
+            return sourceTypeRegs_(InstMetaData::OperandTypes::HALF)
+                   | sourceTypeRegs_(InstMetaData::OperandTypes::SINGLE)
+                   | sourceTypeRegs_(InstMetaData::OperandTypes::DOUBLE);
+        }
+
+        uint64_t getFloatDestRegs() const
+        {
+            return destTypeRegs_(InstMetaData::OperandTypes::HALF)
+                   | destTypeRegs_(InstMetaData::OperandTypes::SINGLE)
+                   | destTypeRegs_(InstMetaData::OperandTypes::DOUBLE);
+        }
+
+        uint64_t getVectorSourceRegs() const
+        {
+            return sourceTypeRegs_(InstMetaData::OperandTypes::VECTOR);
+        }
+
+        uint64_t getVectorDestRegs() const
+        {
+            return destTypeRegs_(InstMetaData::OperandTypes::VECTOR);
+        }
+
+        uint32_t numIntSourceRegs() const
+        {
+            const OperandInfo & opinfo = getSourceOpInfo();
+            return opinfo.getNTypes(InstMetaData::OperandTypes::WORD)
+                   + opinfo.getNTypes(InstMetaData::OperandTypes::LONG);
+        }
+
+        uint32_t numIntDestRegs() const
+        {
+            const OperandInfo & opinfo = getDestOpInfo();
+            return opinfo.getNTypes(InstMetaData::OperandTypes::WORD)
+                   + opinfo.getNTypes(InstMetaData::OperandTypes::LONG);
+        }
+
+        uint32_t numFloatSourceRegs() const
+        {
+            const OperandInfo & opinfo = getSourceOpInfo();
+            return opinfo.getNTypes(InstMetaData::OperandTypes::HALF)
+                   + opinfo.getNTypes(InstMetaData::OperandTypes::SINGLE)
+                   + opinfo.getNTypes(InstMetaData::OperandTypes::DOUBLE);
+        }
+
+        uint32_t numFloatDestRegs() const
+        {
+            const OperandInfo & opinfo = getDestOpInfo();
+            return opinfo.getNTypes(InstMetaData::OperandTypes::HALF)
+                   + opinfo.getNTypes(InstMetaData::OperandTypes::SINGLE)
+                   + opinfo.getNTypes(InstMetaData::OperandTypes::DOUBLE);
+        }
+
+        uint32_t numVectorSourceRegs() const
+        {
+            return getSourceOpInfo().getNTypes(InstMetaData::OperandTypes::VECTOR);
+        }
+
+        uint32_t numVectorDestRegs() const
+        {
+            return getDestOpInfo().getNTypes(InstMetaData::OperandTypes::VECTOR);
         }
 
+        uint64_t getSourceAddressRegs() const { return cold_().addr_sources; }
+
+        uint64_t getSourceDataRegs() const { return cold_().data_sources; }
+
+        bool isHint() const { return fields_().is_hint; }
+
+        ImmediateType getImmediateType() const { return fields_().immediate_type; }
+
+        bool hasImmediate() const { return getImmediateType() != ImmediateType::NONE; }
+
+        uint64_t getImmediate() const { return fields_().immediate; }
+
+        int64_t getSignedOffset() const { return fields_().signed_offset; }
+
+        Float16 getHalfFloatImmediate() const { return cold_().half_float_immediate; }
+
+        Float32 getSingleFloatImmediate() const { return cold_().single_float_immediate; }
+
+        Float64 getDoubleFloatImmediate() const { return cold_().double_float_immediate; }
+
+        Float128 getQuadFloatImmediate() const { return cold_().quad_float_immediate; }
+
+        uint32_t getDataSize() const { return meta_->getDataSize(); }
+
+        const InstMetaData::SpecialFieldsMap & getSpecialFields() const
+        {
+            return cold_().special_fields;
+        }
+
+        uint64_t getExtInstType() const { return ext_itype_; }
+
         bool isExtInstType(ExtractedInstTypes itype) const
         {
-            return (static_cast<std::underlying_type_t<ExtractedInstTypes>>(itype) & ext_itype)
+            return (static_cast<std::underlying_type_t<ExtractedInstTypes>>(itype)
+                    & getExtInstType())
                    == static_cast<std::underlying_type_t<ExtractedInstTypes>>(itype);
         }
 
         bool isExtInstTypeAll(std::underlying_type_t<ExtractedInstTypes> itype) const
         {
-            return (itype & ext_itype) == itype;
+            return (itype & getExtInstType()) == itype;
         }
 
         bool isExtInstTypeAny(std::underlying_type_t<ExtractedInstTypes> itype) const
         {
-            return (itype & ext_itype) != 0;
+            return (itype & getExtInstType()) != 0;
         }
     };
 
@@ -49,6 +49,37 @@ namespace mavis
         }
     };
 
+    /**
+     * Exception thrown when a decode profile file will not open or is malformed
+     */
+    class BadDecodeProfile : public BaseException
+    {
+      public:
+        explicit BadDecodeProfile(const std::string & fname, const std::string & reason) :
+            BaseException()
+        {
+            std::stringstream ss;
+            ss << "Bad decode profile '" << fname << "': " << reason;
+            why_ = ss.str();
+        }
+    };
+
+    /**
+     * Error in a decode image (DecodeImage): missing, truncated, or built by an incompatible
+     * version
+     */
+    class BadDecodeImage : public BaseException
+    {
+      public:
+        explicit BadDecodeImage(const std::string & fname, const std::string & reason) :
+            BaseException()
+        {
+            std::stringstream ss;
+            ss << "Bad decode image '" << fname << "': " << reason;
+            why_ = ss.str();
+        }
+    };
+
     /**
      * DTable build error: the JSON ISA file is missing a mnemonic for the instruction
      */
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mavis
+{
+
+    /**
+     * \brief Map keyed by a small, dense enum: a fixed array of values plus a presence bitmask
+     *
+     * Supports the subset of the std::map interface used for special fields (construction from
+     * {key, value} pairs, operator[], at(), find(), count(), ordered iteration), without any heap
+     * allocation. Iteration visits the present keys in enum order, as std::map would. Entries
+     * are stored as {key, value} pairs, so iterators dereference to references (it->second,
+     * for (const auto & [key, value] : map)).
+     */
+    template <typename KeyType, typename MappedType, uint32_t N> class DenseEnumMap
+    {
+        static_assert(N <= 64, "DenseEnumMap supports at most 64 keys");
+
+      public:
+        using key_type = KeyType;
+        using mapped_type = MappedType;
+        using value_type = std::pair<KeyType, MappedType>;
+        using MaskType = std::conditional_t<(N <= 32), uint32_t, uint64_t>;
+
+        class const_iterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = DenseEnumMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = const value_type &;
+
+            const_iterator() = default;
+
+            const_iterator(const DenseEnumMap* map, MaskType remaining) :
+                map_(map),
+                remaining_(remaining)
+            {
+            }
+
+            reference operator*() const { return map_->entries_[__builtin_ctzll(remaining_)]; }
+
+            pointer operator->() const { return &map_->entries_[__builtin_ctzll(remaining_)]; }
+
+            const_iterator & operator++()
+            {
+                remaining_ &= (remaining_ - 1);
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator prev = *this;
+                ++(*this);
+                return prev;
+            }
+
+            bool operator==(const const_iterator & other) const
+            {
+                return remaining_ == other.remaining_;
+            }
+
+            bool operator!=(const const_iterator & other) const { return !(*this == other); }
+
+          private:
+            const DenseEnumMap* map_ = nullptr;
+            MaskType remaining_ = 0;
+        };
+
+        using iterator = const_iterator;
+
+        DenseEnumMap() = default;
+
+        DenseEnumMap(std::initializer_list<value_type> init)
+        {
+            for (const auto & [key, value] : init)
+            {
+                (*this)[key] = value;
+            }
+        }
+
+        MappedType & operator[](KeyType key)
+        {
+            const uint32_t idx = index_(key);
+            if ((present_ & bit_(idx)) == 0)
+            {
+                present_ |= bit_(idx);
+                entries_[idx] = {key, MappedType()};
+            }
+            return entries_[idx].second;
+        }
+
+        const MappedType & at(KeyType key) const
+        {
+            const uint32_t idx = index_(key);
+            if ((present_ & bit_(idx)) == 0) [[unlikely]]
+            {
+                throw std::out_of_range("DenseEnumMap::at");
+            }
+            return entries_[idx].second;
+        }
+
+        bool contains(KeyType key) const { return (present_ & bit_(index_(key))) != 0; }
+
+        size_t count(KeyType key) const { return contains(key) ? 1 : 0; }
+
+        const_iterator find(KeyType key) const
+        {
+            return contains(key) ? const_iterator(this, present_ & ~(bit_(index_(key)) - 1)) : end();
+        }
+
+        size_t erase(KeyType key)
+        {
+            const size_t n = count(key);
+            present_ &= ~bit_(index_(key));
+            return n;
+        }
+
+        void clear() { present_ = 0; }
+
+        size_t size() const { return __builtin_popcountll(present_); }
+
+        bool empty() const { return present_ == 0; }
+
+        // Bitmask of the keys present (bit i is set for key i)
+        MaskType getPresentMask() const { return present_; }
+
+        const_iterator begin() const { return const_iterator(this, present_); }
+
+        const_iterator end() const { return const_iterator(this, 0); }
+
+        bool operator==(const DenseEnumMap & other) const
+        {
+            if (present_ != other.present_)
+            {
+                return false;
+            }
+            for (MaskType remaining = present_; remaining != 0; remaining &= (remaining - 1))
+            {
+                const uint32_t idx = __builtin_ctzll(remaining);
+                if (!(entries_[idx].second == other.entries_[idx].second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const DenseEnumMap & other) const { return !(*this == other); }
+
+      private:
+        static uint32_t index_(KeyType key)
+        {
+            const auto idx = static_cast<uint32_t>(key);
+            if (idx >= N) [[unlikely]]
+            {
+                throw std::out_of_range("DenseEnumMap: key out of range");
+            }
+            return idx;
+        }
+
+        static constexpr MaskType bit_(uint32_t idx) { return MaskType(1) << idx; }
+
+        std::array<value_type, N> entries_{}; // Only the entries in present_ are valid
+        MaskType present_ = 0;
+    };
+
+} // namespace mavis
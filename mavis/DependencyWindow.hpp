@@ -0,0 +1,266 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "OpcodeInfo.h"
+#include "VectorInst.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cinttypes>
+#include <span>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief Registers read and written by one instruction, in a register-ID space shared by
+     * all of the register files: x0-x31 are IDs 0-31, f0-f31 are 32-63, and v0-v31 are 64-95
+     *
+     * Each set is two 64-bit words (integer and float registers in the first, vector registers
+     * in the second), so set operations are a pair of word operations. x0 is dropped from both
+     * sets: it never carries a dependency.
+     */
+    struct RegisterMasks
+    {
+        static constexpr uint32_t INT_BASE = 0;
+        static constexpr uint32_t FLOAT_BASE = 32;
+        static constexpr uint32_t VECTOR_BASE = 64;
+        static constexpr uint32_t NUM_REGS = 96;
+        static constexpr uint32_t NUM_WORDS = 2;
+
+        uint64_t src[NUM_WORDS] = {0, 0};
+        uint64_t dest[NUM_WORDS] = {0, 0};
+
+        static RegisterMasks build(const OpcodeInfo & opinfo)
+        {
+            constexpr uint64_t X0 = 1;
+            RegisterMasks masks;
+            masks.src[0] = pack_(opinfo.getIntSourceRegs().to_ullong() & ~X0,
+                                 opinfo.getFloatSourceRegs().to_ullong());
+            masks.dest[0] = pack_(opinfo.getIntDestRegs().to_ullong() & ~X0,
+                                  opinfo.getFloatDestRegs().to_ullong());
+            masks.src[1] = static_cast<uint32_t>(opinfo.getVectorSourceRegs().to_ullong());
+            masks.dest[1] = static_cast<uint32_t>(opinfo.getVectorDestRegs().to_ullong());
+            return masks;
+        }
+
+        /**
+         * \brief Replace the vector registers (base registers only, as decoded) with the full
+         * register groups, v0 included, resolved for the current vtype (Mavis::decodeVector())
+         */
+        void setVector(const VectorInst & vinst)
+        {
+            if (vinst.vector)
+            {
+                src[1] = vinst.src_mask;
+                dest[1] = vinst.dest_mask;
+            }
+        }
+
+      private:
+        static uint64_t pack_(const uint64_t int_regs, const uint64_t float_regs)
+        {
+            return static_cast<uint32_t>(int_regs) | (float_regs << FLOAT_BASE);
+        }
+    };
+
+    /**
+     * \brief RAW/WAR/WAW relationships among a window of instructions (a fetch group, a rename
+     * bundle, a ROB), computed in one pass over the window
+     *
+     * For every instruction i, analyze() produces three rows of a dependency matrix, each a
+     * bitset over the instructions of the window (bit j set: i depends on j, j < i):
+     *   - RAW: the nearest earlier writer of each register i reads
+     *   - WAW: the nearest earlier writer of each register i writes
+     *   - WAR: the earlier readers of each register i writes, since that register's last write
+     * plus the producer of each of i's source registers (NO_PRODUCER when the value comes from
+     * outside the window).
+     *
+     * The pass keeps the last writer and a bitset of readers per register ID, valid only for the
+     * registers in the window's running written/read sets, so nothing is cleared per register
+     * between windows. Reader sets are unioned into the WAR rows a word at a time, and sources
+     * not yet written in the window skip the writer table altogether. The instance reuses its
+     * storage, so analyzing successive windows of similar size does not allocate.
+     *
+     * \code
+     * mavis::DependencyWindow deps;
+     * deps.analyzeInsts(rename_group); // Any range of instruction pointers with getOpInfo()
+     * if (deps.dependsOn(3, 1, mavis::DependencyWindow::DepType::RAW)) ...
+     * \endcode
+     */
+    class DependencyWindow
+    {
+      public:
+        enum class DepType : uint8_t
+        {
+            RAW = 0,
+            WAR,
+            WAW,
+            NUM_DEP_TYPES
+        };
+
+        static constexpr uint32_t NO_PRODUCER = 0xffffffff;
+
+        struct SourceProducer
+        {
+            uint32_t reg;      // Unified register ID (see RegisterMasks)
+            uint32_t producer; // Index in the window, or NO_PRODUCER
+        };
+
+        void analyze(std::span<const RegisterMasks> window)
+        {
+            size_ = window.size();
+            words_per_row_ = (size_ + 63) / 64;
+            for (auto & rows : rows_)
+            {
+                rows.assign(size_ * words_per_row_, 0);
+            }
+            readers_.resize(RegisterMasks::NUM_REGS * words_per_row_);
+            producers_.clear();
+            producer_offsets_.assign(size_ + 1, 0);
+
+            uint64_t written[RegisterMasks::NUM_WORDS] = {0, 0};
+            uint64_t read[RegisterMasks::NUM_WORDS] = {0, 0};
+            for (uint32_t i = 0; i < size_; ++i)
+            {
+                const RegisterMasks & masks = window[i];
+                uint64_t* raw = row_(DepType::RAW, i);
+                uint64_t* war = row_(DepType::WAR, i);
+                uint64_t* waw = row_(DepType::WAW, i);
+
+                // Reads see the writers before i
+                for (uint32_t w = 0; w < RegisterMasks::NUM_WORDS; ++w)
+                {
+                    for (uint64_t srcs = masks.src[w]; srcs != 0; srcs &= srcs - 1)
+                    {
+                        const uint32_t bit = std::countr_zero(srcs);
+                        const uint32_t reg = w * 64 + bit;
+                        uint32_t producer = NO_PRODUCER;
+                        if ((written[w] >> bit) & 1)
+                        {
+                            producer = last_writer_[reg];
+                            setBit_(raw, producer);
+                        }
+                        producers_.push_back({reg, producer});
+                    }
+                }
+                producer_offsets_[i + 1] = producers_.size();
+
+                // Writes follow the readers and the last writer of each register
+                for (uint32_t w = 0; w < RegisterMasks::NUM_WORDS; ++w)
+                {
+                    for (uint64_t dests = masks.dest[w]; dests != 0; dests &= dests - 1)
+                    {
+                        const uint32_t bit = std::countr_zero(dests);
+                        const uint32_t reg = w * 64 + bit;
+                        uint64_t* readers = readers_.data() + reg * words_per_row_;
+                        if ((written[w] >> bit) & 1)
+                        {
+                            setBit_(waw, last_writer_[reg]);
+                        }
+                        if ((read[w] >> bit) & 1)
+                        {
+                            for (uint32_t word = 0; word < words_per_row_; ++word)
+                            {
+                                war[word] |= readers[word];
+                                readers[word] = 0;
+                            }
+                        }
+                        last_writer_[reg] = i;
+                    }
+                    written[w] |= masks.dest[w];
+                    read[w] &= ~masks.dest[w];
+                }
+
+                // Reads of registers i did not overwrite wait on later writers
+                for (uint32_t w = 0; w < RegisterMasks::NUM_WORDS; ++w)
+                {
+                    const uint64_t reads = masks.src[w] & ~masks.dest[w];
+                    for (uint64_t srcs = reads & ~read[w]; srcs != 0; srcs &= srcs - 1)
+                    {
+                        const uint32_t reg = w * 64 + std::countr_zero(srcs);
+                        std::fill_n(readers_.data() + reg * words_per_row_, words_per_row_, 0);
+                    }
+                    for (uint64_t srcs = reads; srcs != 0; srcs &= srcs - 1)
+                    {
+                        const uint32_t reg = w * 64 + std::countr_zero(srcs);
+                        setBit_(readers_.data() + reg * words_per_row_, i);
+                    }
+                    read[w] |= reads;
+                }
+            }
+        }
+
+        /**
+         * \brief Analyze a range of instruction pointers (anything with getOpInfo()); vector
+         * operands are the decoded base registers. Build RegisterMasks with
+         * RegisterMasks::setVector() and call analyze() directly for full register groups
+         */
+        template <typename InstRange> void analyzeInsts(const InstRange & insts)
+        {
+            masks_.clear();
+            for (const auto & inst : insts)
+            {
+                masks_.emplace_back(RegisterMasks::build(*inst->getOpInfo()));
+            }
+            analyze(masks_);
+        }
+
+        uint32_t size() const { return size_; }
+
+        // Number of 64-bit words in each dependency row
+        uint32_t getWordsPerRow() const { return words_per_row_; }
+
+        std::span<const uint64_t> getDeps(const DepType type, const uint32_t idx) const
+        {
+            return {row_(type, idx), words_per_row_};
+        }
+
+        bool dependsOn(const uint32_t idx, const uint32_t on, const DepType type) const
+        {
+            return (row_(type, idx)[on / 64] >> (on % 64)) & 1;
+        }
+
+        // True for a dependency of any type
+        bool dependsOn(const uint32_t idx, const uint32_t on) const
+        {
+            return dependsOn(idx, on, DepType::RAW) || dependsOn(idx, on, DepType::WAR)
+                   || dependsOn(idx, on, DepType::WAW);
+        }
+
+        // Producer of every source register of an instruction, in register ID order
+        std::span<const SourceProducer> getProducers(const uint32_t idx) const
+        {
+            return std::span<const SourceProducer>(producers_)
+                .subspan(producer_offsets_[idx],
+                         producer_offsets_[idx + 1] - producer_offsets_[idx]);
+        }
+
+      private:
+        uint32_t size_ = 0;
+        uint32_t words_per_row_ = 0;
+        std::vector<uint64_t> rows_[static_cast<uint32_t>(DepType::NUM_DEP_TYPES)];
+        uint32_t last_writer_[RegisterMasks::NUM_REGS] = {};
+        std::vector<uint64_t> readers_; // Per register ID, valid while the register is read
+        std::vector<SourceProducer> producers_;
+        std::vector<uint32_t> producer_offsets_;
+        std::vector<RegisterMasks> masks_; // analyzeInsts() scratch
+
+        uint64_t* row_(const DepType type, const uint32_t idx)
+        {
+            return rows_[static_cast<uint32_t>(type)].data() + idx * words_per_row_;
+        }
+
+        const uint64_t* row_(const DepType type, const uint32_t idx) const
+        {
+            return rows_[static_cast<uint32_t>(type)].data() + idx * words_per_row_;
+        }
+
+        static void setBit_(uint64_t* row, const uint32_t idx)
+        {
+            row[idx / 64] |= 1ull << (idx % 64);
+        }
+    };
+
+} // namespace mavis
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "DecoderConsts.h"
+#include "DisassemblerIF.hpp"
+#include "ExtractorDirectInfo.h"
+#include "ExtractorWrap.hpp"
+#include "InstMetaData.h"
+#include "OpcodeInfo.h"
+#include <memory>
+#include <string>
+
+namespace mavis
+{
+
+    /**
+     * \brief A pre-resolved handle for building instructions directly (i.e. without an opcode)
+     *
+     * The handle captures everything about the instruction that does not depend on its operand
+     * values: mnemonic, UID, metadata, disassembler, and annotation. Obtain one with
+     * Mavis::prepareDirect() or Mavis::preparePseudoInst(), then pass it to makeInstDirectly(),
+     * makePseudoInst(), or morphInst() along with the operand values. No registry lookups are
+     * done when instantiating from a handle.
+     *
+     * The handle holds shared references to the pieces it resolved, so it remains usable after a
+     * context switch (it still builds instructions as described by the context it was prepared
+     * in). Prepare a new handle to pick up a disassembler set after the handle was made.
+     */
+    template <typename AnnotationType> class DirectInstHandle
+    {
+      public:
+        DirectInstHandle() = default;
+
+        DirectInstHandle(const std::string & mnemonic, const InstructionUniqueID uid,
+                         const InstMetaData::PtrType & meta, const DisassemblerIF::PtrType & dasm,
+                         const typename AnnotationType::PtrType & anno,
+                         const FormGeneric::PtrType & form = nullptr) :
+            mnemonic_(mnemonic),
+            uid_(uid),
+            meta_(meta),
+            dasm_(dasm),
+            anno_(anno),
+            form_(form)
+        {
+        }
+
+        bool isValid() const { return (uid_ != INVALID_UID) && (meta_ != nullptr); }
+
+        const std::string & getMnemonic() const { return mnemonic_; }
+
+        InstructionUniqueID getUID() const { return uid_; }
+
+        const InstMetaData::PtrType & getMetaData() const { return meta_; }
+
+        const typename AnnotationType::PtrType & getAnnotation() const { return anno_; }
+
+        /**
+         * \brief Build the OpcodeInfo for one set of operand values. The mnemonic and UID carried
+         * by ex_info (if any) are ignored; the handle's are used
+         */
+        OpcodeInfo::PtrType makeOpcodeInfo(const ExtractorDirectInfoIF & ex_info) const
+        {
+            ExtractorIF::PtrType extractor = ex_info.clone();
+            if (form_ != nullptr)
+            {
+                // Pseudo instructions augment the operand info with their generic form
+                extractor = makeShared<ExtractorWrap>(extractor, form_);
+            }
+            return makeShared<OpcodeInfo>(
+                Opcode(0),
+                makeShared<DecodedInstructionInfo>(mnemonic_, uid_, extractor, meta_, Opcode(0)),
+                extractor, meta_, dasm_);
+        }
+
+      private:
+        std::string mnemonic_;
+        InstructionUniqueID uid_ = INVALID_UID;
+        InstMetaData::PtrType meta_;
+        DisassemblerIF::PtrType dasm_;
+        typename AnnotationType::PtrType anno_;
+        FormGeneric::PtrType form_; // Only set for pseudo instructions
+    };
+
+} // namespace mavis
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "DecoderExceptions.h"
+#include "InstMetaData.h"
+#include "OpcodeInfo.h"
+
+#include <cinttypes>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief Table of user handlers (e.g. execute functions) indexed by InstructionUniqueID
+     *
+     * Register handlers by mnemonic or by tag while configuring, then resolve() the table against
+     * a Mavis instance once. Resolution turns the registrations into a dense array indexed by
+     * UID, so dispatching a decoded instruction is an array index on its UID (which every
+     * OpcodeInfo already carries) and one indirect call -- no hashing, no string compares:
+     *
+     * \code
+     * mavis::DispatchTable<void (*)(Hart &, const Inst &)> exec;
+     * exec.registerMnemonic("add", &execAdd);
+     * exec.registerTag("vector", &execVector);
+     * exec.resolve(mavis);
+     * ...
+     * exec[inst->getOpInfo()->getInstructionUniqueID()](hart, *inst);
+     * \endcode
+     *
+     * A mnemonic registration takes precedence over a tag registration, and tags are tried in
+     * registration order; instructions matching neither get the default handler (a
+     * value-initialized Handler unless setDefault() is called). Compressed instructions share
+     * the UID (and so the handler) of their expansion. Overlays (nop, mv, ret, ...) have UIDs of
+     * their own: without a registration of their own mnemonic they use the registration of the
+     * instruction they overlay, and so on down the chain (nop overlays li, which overlays addi),
+     * then the tags of their metadata.
+     *
+     * UIDs belong to one context, so resolve() again after switching contexts.
+     *
+     * \tparam Handler Any copyable callable (function pointer, std::function, ...)
+     */
+    template <typename Handler> class DispatchTable
+    {
+      public:
+        void registerMnemonic(const std::string & mnemonic, const Handler & handler)
+        {
+            by_mnemonic_[mnemonic] = handler;
+        }
+
+        void registerTag(const std::string & tag, const Handler & handler)
+        {
+            by_tag_.emplace_back(tag, handler);
+        }
+
+        void setDefault(const Handler & handler) { default_ = handler; }
+
+        /**
+         * \brief Build the UID-indexed table for the current context of a Mavis instance
+         * \throws UnknownMnemonic if a registered mnemonic is not in the context
+         */
+        template <typename MavisType> void resolve(const MavisType & mavis)
+        {
+            for (const auto & [mnemonic, handler] : by_mnemonic_)
+            {
+                if (mavis.lookupInstructionUniqueID(mnemonic) == INVALID_UID)
+                {
+                    throw UnknownMnemonic(mnemonic);
+                }
+            }
+
+            struct Inst
+            {
+                std::string mnemonic;
+                InstructionUniqueID uid;
+                InstMetaData::PtrType meta;
+            };
+
+            std::vector<Inst> insts;
+            std::unordered_map<std::string, std::string> bases; // Overlay to overlaid mnemonic
+            mavis.forEachInstruction(
+                [&insts, &bases](const std::string & mnemonic, const InstructionUniqueID uid,
+                                 const InstMetaData::PtrType & meta,
+                                 const std::string & base_mnemonic)
+                {
+                    insts.push_back({mnemonic, uid, meta});
+                    if (base_mnemonic != mnemonic)
+                    {
+                        bases.emplace(mnemonic, base_mnemonic);
+                    }
+                });
+
+            table_.clear();
+            for (const auto & inst : insts)
+            {
+                if (inst.uid >= table_.size())
+                {
+                    table_.resize(inst.uid + 1, default_);
+                }
+                table_[inst.uid] = find_(inst.mnemonic, bases, inst.meta);
+            }
+        }
+
+        bool isResolved() const { return !table_.empty(); }
+
+        // Handler of a UID; no bounds checking beyond what resolve() guarantees
+        const Handler & operator[](const InstructionUniqueID uid) const { return table_[uid]; }
+
+        const Handler & at(const InstructionUniqueID uid) const
+        {
+            return (uid < table_.size()) ? table_[uid] : default_;
+        }
+
+        const Handler & at(const OpcodeInfo & opinfo) const
+        {
+            return at(opinfo.getInstructionUniqueID());
+        }
+
+      private:
+        std::unordered_map<std::string, Handler> by_mnemonic_;
+        std::vector<std::pair<std::string, Handler>> by_tag_;
+        Handler default_{};
+        std::vector<Handler> table_;
+
+        const Handler & find_(const std::string & mnemonic,
+                              const std::unordered_map<std::string, std::string> & bases,
+                              const InstMetaData::PtrType & meta) const
+        {
+            // The mnemonic, then the instructions it overlays (bounded, in case of a cycle)
+            const std::string* name = &mnemonic;
+            for (size_t depth = 0; depth <= bases.size(); ++depth)
+            {
+                if (const auto itr = by_mnemonic_.find(*name); itr != by_mnemonic_.end())
+                {
+                    return itr->second;
+                }
+                const auto base = bases.find(*name);
+                if (base == bases.end())
+                {
+                    break;
+                }
+                name = &base->second;
+            }
+            if (meta != nullptr)
+            {
+                for (const auto & [tag, handler] : by_tag_)
+                {
+                    if (meta->getTags().isMember(tag))
+                    {
+                        return handler;
+                    }
+                }
+            }
+            return default_;
+        }
+    };
+
+} // namespace mavis
@@ -5,6 +5,8 @@
 #include "DecoderConsts.h"
 #include "Swizzler.hpp"
 #include "GenericRegistryTraits.h"
+#include "InlineVector.hpp"
+#include <initializer_list>
 #include <map>
 #include <algorithm>
 
@@ -13,15 +15,16 @@ namespace mavis
     /**
      * ExtractorIF: Interface to Extractors
      */
-    class ExtractorIF
+    class ExtractorIF : public RefCounted
     {
         friend class ExtractorWrap;
 
       public:
         using OpcodeFieldValueType = OperandInfo::OpcodeFieldValueType;
 
-        typedef std::shared_ptr<ExtractorIF> PtrType;
-        typedef std::vector<OpcodeFieldValueType> RegListType;
+        typedef SharedPtr<ExtractorIF> PtrType;
+        // Register lists rarely exceed a few entries; keep them off the heap
+        typedef InlineVector<OpcodeFieldValueType, 8> RegListType;
         typedef std::vector<uint32_t> ValueListType;
 
         static inline const std::string & getSpecialFieldName(InstMetaData::SpecialField sid)
@@ -93,6 +96,44 @@ namespace mavis
         // Special fields are cached in DecodedInstInfo
         virtual InstMetaData::SpecialFieldsMap getSpecialFields(Opcode icode, const InstMetaData::PtrType & meta) const = 0;
 
+        /**
+         * \brief The fields of an opcode that DecodedInstructionInfo memoizes, filled in by a
+         * single call to extractAll()
+         */
+        struct ExtractedFields
+        {
+            uint64_t sources = 0;
+            uint64_t dests = 0;
+            uint64_t immediate = 0;
+            int64_t signed_offset = 0;
+            ImmediateType immediate_type = ImmediateType::NONE;
+            bool is_hint = false;
+            OperandInfo source_opinfo;
+            OperandInfo dest_opinfo;
+        };
+
+        /**
+         * \brief Extract the commonly used fields of an opcode in one call
+         *
+         * The default implementation goes through the individual methods above, which remain the
+         * reference. Extractors for the common forms override this to read each opcode field
+         * only once. `fields` must start out default constructed (overrides only fill in what
+         * their form has). NOTE: an extractor deriving from one that overrides extractAll() must
+         * override it again if it changes any of the register or operand methods
+         */
+        virtual void extractAll(Opcode icode, const InstMetaData::PtrType & meta,
+                                ExtractedFields & fields) const
+        {
+            fields.sources = getSourceRegs(icode);
+            fields.dests = getDestRegs(icode);
+            fields.immediate_type = getImmediateType();
+            fields.immediate = getImmediate(icode);
+            fields.signed_offset = getSignedOffset(icode);
+            fields.is_hint = isHint(icode);
+            fields.source_opinfo = getSourceOperandInfo(icode, meta);
+            fields.dest_opinfo = getDestOperandInfo(icode, meta);
+        }
+
         virtual std::string dasmString(const std::string & mnemonic, Opcode icode) const = 0;
 
         // This version of dasmString can be overridden in the derived classes to take advantage
@@ -209,7 +250,7 @@ namespace mavis
 
         static inline uint64_t extract_(const typename FormType::idType fid, const Opcode icode)
         {
-            return FormType::fields[fid].extract(icode);
+            return FormType::field_layout[fid].extract(icode);
         }
 
         static inline bool isFixedField_(const typename FormType::idType fid, const uint64_t fset)
@@ -219,7 +260,7 @@ namespace mavis
 
         static inline bool isMaskedField_(const typename FormType::idType fid, const uint64_t mask)
         {
-            return (FormType::fields[fid].getShiftedMask() & mask) != 0ull;
+            return (FormType::field_layout[fid].getShiftedMask() & mask) != 0ull;
         }
 
         // TODO: Deprecate all uses of fixed_field_set! It's DANGEROUS
@@ -250,7 +291,8 @@ namespace mavis
         static inline uint64_t extractCompressedRegister_(const typename FormType::idType fid,
                                                           const Opcode icode)
         {
-            return FormType::fields[fid].extract(icode) + 8; // Compressed registers are offset by 8
+            // Compressed registers are offset by 8
+            return FormType::field_layout[fid].extract(icode) + 8;
         }
 
         static inline uint64_t extractCompressedIndexBit_(const typename FormType::idType fid,
@@ -399,6 +441,60 @@ namespace mavis
 
         typedef std::vector<RegType_> RegTypeList_;
 
+        struct OperandField_
+        {
+            typename FormType::idType fid;
+            InstMetaData::OperandFieldID mid;
+            bool is_store_data = false;
+        };
+
+        // Single pass equivalent of extractUnmaskedIndexBit_() and appendUnmaskedOperandInfo_()
+        // over a list of register fields, for use by extractAll()
+        static inline void extractUnmaskedOperands_(const Opcode icode,
+                                                    const InstMetaData::PtrType & meta,
+                                                    const uint64_t mask,
+                                                    std::initializer_list<OperandField_> flist,
+                                                    uint64_t & bits, OperandInfo & olist)
+        {
+            for (const auto & f : flist)
+            {
+                if (!isMaskedField_(f.fid, mask))
+                {
+                    const uint64_t reg = extract_(f.fid, icode);
+                    bits |= 1ull << reg;
+                    olist.addElement(f.mid, meta->getOperandType(f.mid), reg, f.is_store_data);
+                }
+            }
+        }
+
+        // Compressed register (x8-x15) version of extractUnmaskedOperands_()
+        static inline void
+        extractUnmaskedCompressedOperands_(const Opcode icode, const InstMetaData::PtrType & meta,
+                                           const uint64_t mask,
+                                           std::initializer_list<OperandField_> flist,
+                                           uint64_t & bits, OperandInfo & olist)
+        {
+            for (const auto & f : flist)
+            {
+                if (!isMaskedField_(f.fid, mask))
+                {
+                    const uint64_t reg = extractCompressedRegister_(f.fid, icode);
+                    bits |= 1ull << reg;
+                    olist.addElement(f.mid, meta->getOperandType(f.mid), reg, f.is_store_data);
+                }
+            }
+        }
+
+        // The immediate and hint part of the default extractAll(), for single pass overrides
+        // whose derived extractors change the immediate or the hint
+        void extractImmediate_(const Opcode icode, ExtractedFields & fields) const
+        {
+            fields.immediate_type = getImmediateType();
+            fields.immediate = getImmediate(icode);
+            fields.signed_offset = getSignedOffset(icode);
+            fields.is_hint = isHint(icode);
+        }
+
         static inline std::string dasmFormatRegList_(const InstMetaData::PtrType & meta,
                                                      const Opcode icode, uint64_t fixed_field_mask,
                                                      const RegTypeList_ & rtlist)
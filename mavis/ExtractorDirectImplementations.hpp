@@ -40,7 +40,7 @@ public:
 
     ExtractorIF::PtrType clone() const override
     {
-        return std::make_shared<ExtractorPseudoInfo>(*this);
+        return makeShared<ExtractorPseudoInfo>(*this);
     }
 
     std::string getName() const override
@@ -134,6 +134,16 @@ public:
         return ss.str();
     }
 
+    bool appendSignature(SignatureType & sig) const override
+    {
+        if (!appendBaseSignature_(sig, typeid(ExtractorPseudoInfo))) {
+            return false;
+        }
+        appendSignature_(sig, sources_);
+        appendSignature_(sig, dests_);
+        return true;
+    }
+
 private:
     const OperandInfo sources_;
     const OperandInfo dests_;
@@ -162,7 +172,7 @@ public:
 
     ExtractorIF::PtrType clone() const override
     {
-        return std::make_shared<ExtractorDirectInfoBitMask>(*this);
+        return makeShared<ExtractorDirectInfoBitMask>(*this);
     }
 
     std::string getName() const override
@@ -230,6 +240,16 @@ public:
         return ss.str();
     }
 
+    bool appendSignature(SignatureType & sig) const override
+    {
+        if (!appendBaseSignature_(sig, typeid(ExtractorDirectInfoBitMask))) {
+            return false;
+        }
+        sig.push_back(sources_);
+        sig.push_back(dests_);
+        return true;
+    }
+
 private:
     const uint64_t sources_;
     const uint64_t dests_;
@@ -270,7 +290,7 @@ public:
 
     ExtractorIF::PtrType clone() const override
     {
-        return std::make_shared<ExtractorDirectInfo_Stores>(*this);
+        return makeShared<ExtractorDirectInfo_Stores>(*this);
     }
 
     std::string getName() const override
@@ -343,6 +363,16 @@ public:
         return ss.str();
     }
 
+    bool appendSignature(SignatureType & sig) const override
+    {
+        if (!appendBaseSignature_(sig, typeid(ExtractorDirectInfo_Stores))) {
+            return false;
+        }
+        appendSignature_(sig, addr_sources_);
+        appendSignature_(sig, data_sources_);
+        return true;
+    }
+
 private:
     const RegListType addr_sources_;
     const RegListType data_sources_;
@@ -371,7 +401,7 @@ public:
 
     ExtractorIF::PtrType clone() const override
     {
-        return std::make_shared<ExtractorDirectInfoBitMask_Stores>(*this);
+        return makeShared<ExtractorDirectInfoBitMask_Stores>(*this);
     }
 
     std::string getName() const override
@@ -442,6 +472,16 @@ public:
         return ss.str();
     }
 
+    bool appendSignature(SignatureType & sig) const override
+    {
+        if (!appendBaseSignature_(sig, typeid(ExtractorDirectInfoBitMask_Stores))) {
+            return false;
+        }
+        sig.push_back(addr_sources_);
+        sig.push_back(data_sources_);
+        return true;
+    }
+
 private:
     const uint64_t addr_sources_;
     const uint64_t data_sources_;
@@ -472,7 +512,7 @@ public:
 
     ExtractorIF::PtrType clone() const override
     {
-        return std::make_shared<ExtractorDirectInfoBitMask_DestStores>(*this);
+        return makeShared<ExtractorDirectInfoBitMask_DestStores>(*this);
     }
 
     std::string getName() const override
@@ -543,6 +583,17 @@ public:
         return ss.str();
     }
 
+    bool appendSignature(SignatureType & sig) const override
+    {
+        if (!appendBaseSignature_(sig, typeid(ExtractorDirectInfoBitMask_DestStores))) {
+            return false;
+        }
+        sig.push_back(addr_sources_);
+        sig.push_back(data_sources_);
+        sig.push_back(dests_);
+        return true;
+    }
+
 private:
     const uint64_t addr_sources_;
     const uint64_t data_sources_;
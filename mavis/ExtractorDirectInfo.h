@@ -4,6 +4,8 @@
 #include "DecoderExceptions.h"
 #include "Extractor.h"
 #include <string>
+#include <typeinfo>
+#include <vector>
 
 namespace mavis
 {
@@ -20,6 +22,21 @@ namespace mavis
 
         virtual InstructionUniqueID getUID() const = 0;
 
+        typedef std::vector<uint64_t> SignatureType;
+
+        /**
+         * \brief Append a complete description of the operand contents (registers, immediate,
+         * special fields) to sig. Two direct infos with equal signatures must produce identical
+         * instructions; this is what lets morphInst() memoize its results.
+         * \return false if the contents can't be summarized, in which case nothing is memoized
+         * (the default)
+         */
+        virtual bool appendSignature(SignatureType & sig) const
+        {
+            (void)sig;
+            return false;
+        }
+
         bool isIllop(Opcode) const override { return false; }
 
         bool isHint(Opcode) const override { return false; }
@@ -262,6 +279,54 @@ namespace mavis
 
         const std::string & dasmGetAnnotation_() const { return annotation_; }
 
+        /**
+         * \brief Append the signature of the state common to all direct extractors. Derived
+         * classes call this first from appendSignature(), naming their own type so that
+         * further-derived classes (which may carry more state) are never memoized by accident
+         */
+        bool appendBaseSignature_(SignatureType & sig, const std::type_info & type) const
+        {
+            if ((typeid(*this) != type) || !annotation_.empty())
+            {
+                return false;
+            }
+            sig.push_back(type.hash_code());
+            sig.push_back(immediate_);
+            sig.push_back(static_cast<uint64_t>(immediate_type_));
+            appendSignature_(sig, specials_);
+            return true;
+        }
+
+        static void appendSignature_(SignatureType & sig, const RegListType & regs)
+        {
+            sig.push_back(regs.size());
+            sig.insert(sig.end(), regs.begin(), regs.end());
+        }
+
+        static void appendSignature_(SignatureType & sig,
+                                     const InstMetaData::SpecialFieldsMap & specials)
+        {
+            sig.push_back(specials.size());
+            for (const auto & [sf, value] : specials)
+            {
+                sig.push_back((static_cast<uint64_t>(sf) << 32) | value);
+            }
+        }
+
+        static void appendSignature_(SignatureType & sig, const OperandInfo & opinfo)
+        {
+            const OperandInfo::ElementList & elems = opinfo.getElements();
+            sig.push_back(elems.size());
+            for (const auto & elem : elems)
+            {
+                sig.push_back((static_cast<uint64_t>(elem.field_value) << 32)
+                              | (static_cast<uint64_t>(elem.is_implied) << 17)
+                              | (static_cast<uint64_t>(elem.is_store_data) << 16)
+                              | (static_cast<uint64_t>(elem.operand_type) << 8)
+                              | static_cast<uint64_t>(elem.field_id));
+            }
+        }
+
       private:
         std::string annotation_;
     };
@@ -346,7 +411,7 @@ namespace mavis
 
         ExtractorIF::PtrType clone() const override
         {
-            return std::make_shared<ExtractorDirectInfo>(*this);
+            return makeShared<ExtractorDirectInfo>(*this);
         }
 
         std::string getName() const override { return name_; }
@@ -510,6 +575,18 @@ namespace mavis
             return ss.str();
         }
 
+        bool appendSignature(SignatureType & sig) const override
+        {
+            if (!appendBaseSignature_(sig, typeid(ExtractorDirectInfo)))
+            {
+                return false;
+            }
+            appendSignature_(sig, sources_);
+            appendSignature_(sig, dests_);
+            appendSignature_(sig, specials_);
+            return true;
+        }
+
       private:
         const RegListType sources_;
         const RegListType dests_;
@@ -592,7 +669,7 @@ namespace mavis
 
         ExtractorIF::PtrType clone() const override
         {
-            return std::make_shared<ExtractorDirectOpInfoList>(*this);
+            return makeShared<ExtractorDirectOpInfoList>(*this);
         }
 
         std::string getName() const override { return name_; }
@@ -684,6 +761,17 @@ namespace mavis
             return ss.str();
         }
 
+        bool appendSignature(SignatureType & sig) const override
+        {
+            if (!appendBaseSignature_(sig, typeid(ExtractorDirectOpInfoList)))
+            {
+                return false;
+            }
+            appendSignature_(sig, sources_);
+            appendSignature_(sig, dests_);
+            return true;
+        }
+
       private:
         const OperandInfo sources_;
         const OperandInfo dests_;
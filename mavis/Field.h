@@ -10,6 +10,30 @@
 namespace mavis
 {
 
+    /**
+     * FieldDescriptor: compile-time description of a field (name, position and length). Forms
+     * declare their layout with these so that extractors can read a field with a constant
+     * shift and mask
+     */
+    struct FieldDescriptor
+    {
+        const char* name;
+        uint32_t rpos;
+        uint32_t len;
+
+        constexpr uint64_t getMask() const
+        {
+            return -1ull >> (mavis::utils::num_bits<uint64_t> - len);
+        }
+
+        constexpr uint64_t getShiftedMask() const { return getMask() << rpos; }
+
+        constexpr uint64_t extract(const uint64_t icode) const
+        {
+            return (icode >> rpos) & getMask();
+        }
+    };
+
     /**
      * Field
      */
@@ -26,6 +50,8 @@ namespace mavis
             size_ = 1 << len_;
         }
 
+        explicit Field(const FieldDescriptor & fd) : Field(fd.name, fd.rpos, fd.len) {}
+
         Field(const Field &) = default;
 
         virtual Field* clone() const { return new Field(*this); }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include "Field.h"
 #include "mavis/DecoderExceptions.h"
@@ -59,6 +60,13 @@ namespace mavis
 
     typedef const std::vector<Field> FieldsType;
 
+    // Build a Form's runtime field list from its compile-time layout
+    template <size_t N>
+    inline std::vector<Field> makeFields(const std::array<FieldDescriptor, N> & layout)
+    {
+        return std::vector<Field>(layout.begin(), layout.end());
+    }
+
     /**
      * Form Base to provide common interface for templated Form class
      */
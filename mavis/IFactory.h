@@ -4,20 +4,59 @@
 #include <iostream>
 #include <sstream>
 #include <functional>
+#include <typeinfo>
+#include <algorithm>
 #include <array>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <memory>
+#include <optional>
 #include "DecoderTypes.h"
 #include "OpcodeInfo.h"
 #include "Extractor.h"
+#include "DirectInstHandle.hpp"
 #include "InstructionRegistry.hpp"
 #include "Stash.hpp"
 #include "Overlay.hpp"
+#include "MaskMatchTable.hpp"
 
 namespace mavis
 {
 
+    /**
+     * \brief Shape of a decode trie, as reported by DTable::optimize()
+     *
+     * Nodes are counted once per path that reaches them (leaf factories shared by several
+     * special cases are counted for each). Depth is the number of nodes from the root to a leaf.
+     */
+    struct TrieStats
+    {
+        uint32_t num_nodes = 0;
+        uint32_t num_dense = 0;        // Dense tables (including merged fields)
+        uint32_t num_sparse = 0;       // Sparse (flat or map based) tables
+        uint32_t num_match = 0;        // Collapsed single-child chains
+        uint32_t num_special_case = 0; // Special case (fixed field) resolvers
+        uint32_t num_leaves = 0;
+        uint32_t max_depth = 0;
+        uint64_t num_table_slots = 0; // Total child slots in dense and sparse tables
+
+        void addNode(uint32_t depth)
+        {
+            ++num_nodes;
+            max_depth = std::max(max_depth, depth + 1);
+        }
+    };
+
+    inline std::ostream & operator<<(std::ostream & os, const TrieStats & stats)
+    {
+        os << "nodes=" << stats.num_nodes << " (dense=" << stats.num_dense
+           << ", sparse=" << stats.num_sparse << ", match=" << stats.num_match
+           << ", special_case=" << stats.num_special_case << ", leaves=" << stats.num_leaves
+           << "), max_depth=" << stats.max_depth << ", table_slots=" << stats.num_table_slots;
+        return os;
+    }
+
     /**
      * IFactoryIF<InstType, AnnotationType>: IFactory interface (Composite Pattern)
      */
@@ -26,9 +65,9 @@ namespace mavis
       public:
         typedef typename std::shared_ptr<IFactoryIF> PtrType;
 
-        struct IFactoryInfo
+        struct IFactoryInfo : public RefCounted
         {
-            typedef std::shared_ptr<IFactoryInfo> PtrType;
+            typedef SharedPtr<IFactoryInfo> PtrType;
 
             const OpcodeInfo::PtrType opinfo;
             const typename AnnotationType::PtrType uinfo;
@@ -41,6 +80,52 @@ namespace mavis
             }
         };
 
+        /**
+         * \brief Structural description of a node, for tools that walk the trie (see
+         * StaticDecoderWriter). Nodes that do not describe themselves report Kind::OTHER
+         */
+        struct NodeView
+        {
+            enum class Kind
+            {
+                OTHER,
+                FIELD,        // Child by field value; default on a missing child or UnknownOpcode
+                MATCH_LIST,   // Child by select(); default if the selected child is missing
+                MATCH,        // Single child, reached when (icode & mask) == value
+                SPECIAL_CASE, // First matching case, then the default case
+                LEAF          // IFactory
+            };
+
+            struct Case
+            {
+                std::string mnemonic;
+                Opcode mask = 0;
+                Opcode value = 0;
+                PtrType factory;
+                ExtractorIF::PtrType extractor;
+            };
+
+            Kind kind = Kind::OTHER;
+
+            // FIELD: the field; children are (field value, child)
+            const Field* field = nullptr;
+
+            // FIELD, MATCH (one child), MATCH_LIST (matcher index, child or nullptr)
+            std::vector<std::pair<uint64_t, PtrType>> children;
+            PtrType dflt = nullptr;
+
+            // MATCH: mask/value. MATCH_LIST: mask of the opcode bits select() depends on
+            Opcode mask = 0;
+            Opcode value = 0;
+
+            // MATCH_LIST: index of the selected matcher (children.size() if none)
+            std::function<uint32_t(Opcode)> select;
+
+            // SPECIAL_CASE: cases in match order, and the default case (if any)
+            std::vector<Case> cases;
+            std::optional<Case> default_case;
+        };
+
       public:
         virtual ~IFactoryIF() = default;
 
@@ -55,6 +140,26 @@ namespace mavis
         virtual typename IFactoryInfo::PtrType getInfo(const std::string & mnemonic, Opcode icode,
                                                        const ExtractorIF::PtrType & extractor) = 0;
 
+        /**
+         * \brief Instruction type bits of an opcode (InstMetaData::InstructionTypes plus
+         * DecodedInstructionInfo::ExtractedInstTypes)
+         */
+        struct TypeBits
+        {
+            std::underlying_type_t<InstMetaData::InstructionTypes> inst_types = 0;
+            std::underlying_type_t<DecodedInstructionInfo::ExtractedInstTypes> ext_inst_types = 0;
+        };
+
+        /**
+         * \brief Walk to the leaf like getInfo(), but only resolve the type bits: no decoded
+         * info is built and nothing is cached (see DTable::classify()). Same exceptions as
+         * getInfo()
+         */
+        virtual TypeBits getTypes(Opcode icode) = 0;
+
+        virtual TypeBits getTypes(const std::string & mnemonic, Opcode icode,
+                                  const ExtractorIF::PtrType & extractor) = 0;
+
         virtual typename IFactoryIF<InstType, AnnotationType>::PtrType
         getNode(const Opcode istencil) = 0;
 
@@ -81,6 +186,26 @@ namespace mavis
         addDefaultIFactory(const typename IFactoryIF<InstType, AnnotationType>::PtrType & node) = 0;
 
         virtual void print(std::ostream & os, const uint32_t level = 0) const = 0;
+
+        /**
+         * \brief Restructure the subtree rooted at this node for faster lookup, once the trie is
+         * fully built. Decode results are unchanged
+         * \param self Shared pointer to this node
+         * \return The node to use in place of this one (self if it is kept)
+         */
+        virtual PtrType optimize(const PtrType & self) { return self; }
+
+        /**
+         * \brief Accumulate the shape of the subtree rooted at this node
+         * \param depth Depth of this node (the root is at depth 0)
+         */
+        virtual void gatherStats(TrieStats & stats, const uint32_t depth) const
+        {
+            stats.addNode(depth);
+            ++stats.num_leaves;
+        }
+
+        virtual NodeView getView() const { return NodeView(); }
     };
 
     template <typename InstType, typename AnnotationType>
@@ -208,6 +333,7 @@ namespace mavis
                 table_.push_back({mnemonic, mask, field_set, istencil & mask,
                                   static_cast<uint32_t>(flist.size()), nullptr});
             }
+            compileTable_();
 
             // Perform a little sanity check to be sure the istencil matches only one of the table
             // entries under the same mask. If not, then the encoding is not unique (more encoding
@@ -241,15 +367,9 @@ namespace mavis
         typename IFactoryIF<InstType, AnnotationType>::PtrType
         getNode(const Opcode istencil) override
         {
-            for (const auto & entry : table_)
-            {
-                // The first match will be the most specific match
-                if ((istencil & entry.mask) == entry.value)
-                {
-                    return entry.factory;
-                }
-            }
-            return default_.factory;
+            // The first match will be the most specific match
+            const uint32_t idx = matcher_.find(istencil);
+            return (idx != MaskMatchTable::NO_MATCH) ? table_[idx].factory : default_.factory;
         }
 
         typename IFactoryIF<InstType, AnnotationType>::PtrType getDefault() const override
@@ -264,15 +384,13 @@ namespace mavis
             mavis::utils::notNull(node);
             mavis::utils::notNull(extractor);
 
-            for (auto & entry : table_)
+            // The first match will be the most specific match
+            if (const uint32_t idx = matcher_.find(istencil); idx != MaskMatchTable::NO_MATCH)
             {
-                // The first match will be the most specific match
-                if ((istencil & entry.mask) == entry.value)
-                {
-                    entry.factory = node;
-                    entry.extractor = extractor->specialCaseClone(entry.mask, entry.field_set);
-                    return;
-                }
+                auto & entry = table_[idx];
+                entry.factory = node;
+                entry.extractor = extractor->specialCaseClone(entry.mask, entry.field_set);
+                return;
             }
 
             // If this is not true, then we've already assigned a default
@@ -305,19 +423,17 @@ namespace mavis
         typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
         getInfo(Opcode icode) override
         {
-            for (const auto & entry : table_)
+            // The first match will be the most specific match
+            if (const uint32_t idx = matcher_.find(icode); idx != MaskMatchTable::NO_MATCH)
             {
-                // The first match will be the most specific match
-                if ((icode & entry.mask) == entry.value)
+                const auto & entry = table_[idx];
+                // Check for illegal opcode
+                if (entry.extractor->isIllop(icode))
                 {
-                    // Check for illegal opcode
-                    if (entry.extractor->isIllop(icode))
-                    {
-                        throw IllegalOpcode(entry.mnemonic, icode);
-                    }
-                    return mavis::utils::notNull(entry.factory)
-                        ->getInfo(entry.mnemonic, icode, entry.extractor);
+                    throw IllegalOpcode(entry.mnemonic, icode);
                 }
+                return mavis::utils::notNull(entry.factory)
+                    ->getInfo(entry.mnemonic, icode, entry.extractor);
             }
 
             if (default_.factory != nullptr)
@@ -351,6 +467,63 @@ namespace mavis
             }
         }
 
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode icode) override
+        {
+            // Same case selection as getInfo()
+            if (const uint32_t idx = matcher_.find(icode); idx != MaskMatchTable::NO_MATCH)
+            {
+                const auto & entry = table_[idx];
+                if (entry.extractor->isIllop(icode))
+                {
+                    throw IllegalOpcode(entry.mnemonic, icode);
+                }
+                return mavis::utils::notNull(entry.factory)
+                    ->getTypes(entry.mnemonic, icode, entry.extractor);
+            }
+
+            if (default_.factory != nullptr)
+            {
+                if (default_.extractor->isIllop(icode))
+                {
+                    throw IllegalOpcode(default_.mnemonic, icode);
+                }
+                return default_.factory->getTypes(default_.mnemonic, icode, default_.extractor);
+            }
+            throw UnknownOpcode(icode);
+        }
+
+        void gatherStats(TrieStats & stats, const uint32_t depth) const override
+        {
+            stats.addNode(depth);
+            ++stats.num_special_case;
+            for (const auto & entry : table_)
+            {
+                mavis::utils::notNull(entry.factory)->gatherStats(stats, depth + 1);
+            }
+            if (default_.factory != nullptr)
+            {
+                default_.factory->gatherStats(stats, depth + 1);
+            }
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::NodeView getView() const override
+        {
+            using NodeView = typename IFactoryIF<InstType, AnnotationType>::NodeView;
+            NodeView view;
+            view.kind = NodeView::Kind::SPECIAL_CASE;
+            for (const auto & entry : table_)
+            {
+                view.cases.push_back(
+                    {entry.mnemonic, entry.mask, entry.value, entry.factory, entry.extractor});
+            }
+            if (default_.factory != nullptr)
+            {
+                view.default_case = typename NodeView::Case{default_.mnemonic, 0, 0,
+                                                            default_.factory, default_.extractor};
+            }
+            return view;
+        }
+
         void flushCaches() override
         {
             for (auto & entry : table_)
@@ -412,6 +585,20 @@ namespace mavis
         std::vector<SpecialCaseEntry> table_;
         SpecialCaseEntry default_;
 
+        // table_ compiled for lookup (same most-specific-first order)
+        MaskMatchTable matcher_;
+
+        void compileTable_()
+        {
+            std::vector<std::pair<Opcode, Opcode>> rules;
+            rules.reserve(table_.size());
+            for (const auto & entry : table_)
+            {
+                rules.emplace_back(entry.mask, entry.value);
+            }
+            matcher_.build(rules);
+        }
+
         const Field* getField() const override
         {
             throw std::runtime_error("Unimplemented");
@@ -438,6 +625,12 @@ namespace mavis
             throw std::runtime_error("Unimplemented");
             return nullptr;
         }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits
+        getTypes(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
     };
 
     /**
@@ -506,27 +699,46 @@ namespace mavis
         typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
         getInfo(Opcode icode) override
         {
-            const auto itr = hash_.find(icode & mask_);
-            if (itr != hash_.end())
+            return findChild_(icode)->getInfo(icode);
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode icode) override
+        {
+            return findChild_(icode)->getTypes(icode);
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::PtrType
+        optimize(const typename IFactoryIF<InstType, AnnotationType>::PtrType & self) override
+        {
+            for (auto & [key, ifact] : hash_)
             {
-                if (itr->second == nullptr) [[unlikely]]
+                if (ifact != nullptr)
                 {
-                    throw std::runtime_error("cannot find hash entry for opcode");
+                    ifact = ifact->optimize(ifact);
                 }
-                return itr->second->getInfo(icode);
             }
-            else if (default_ != nullptr)
+            if (default_ != nullptr)
             {
-                return default_->getInfo(icode);
+                default_ = default_->optimize(default_);
             }
-            else
+            return self;
+        }
+
+        void gatherStats(TrieStats & stats, const uint32_t depth) const override
+        {
+            stats.addNode(depth);
+            ++stats.num_sparse;
+            stats.num_table_slots += hash_.size();
+            for (const auto & [key, ifact] : hash_)
             {
-                std::ostringstream ss;
-                ss << "CANT FIND FACTORY FOR ICODE: 0x" << std::hex << icode << std::endl;
-                ss << "MASK = 0x" << std::hex << mask_ << std::endl;
-                ss << this;
-                throw std::runtime_error(ss.str());
-                return nullptr;
+                if (ifact != nullptr)
+                {
+                    ifact->gatherStats(stats, depth + 1);
+                }
+            }
+            if (default_ != nullptr)
+            {
+                default_->gatherStats(stats, depth + 1);
             }
         }
 
@@ -582,6 +794,33 @@ namespace mavis
         Field* field_;
         Opcode mask_;
 
+        // The child that decodes icode (the default if icode has no entry of its own)
+        const typename IFactoryIF<InstType, AnnotationType>::PtrType &
+        findChild_(Opcode icode) const
+        {
+            const auto itr = hash_.find(icode & mask_);
+            if (itr != hash_.end())
+            {
+                if (itr->second == nullptr) [[unlikely]]
+                {
+                    throw std::runtime_error("cannot find hash entry for opcode");
+                }
+                return itr->second;
+            }
+            else if (default_ != nullptr)
+            {
+                return default_;
+            }
+            else
+            {
+                std::ostringstream ss;
+                ss << "CANT FIND FACTORY FOR ICODE: 0x" << std::hex << icode << std::endl;
+                ss << "MASK = 0x" << std::hex << mask_ << std::endl;
+                ss << this;
+                throw std::runtime_error(ss.str());
+            }
+        }
+
         Opcode getStencil() const override { return 0; };
 
         void addIFactory(const std::string &, const Opcode,
@@ -597,115 +836,576 @@ namespace mavis
             throw std::runtime_error("Unimplemented");
             return nullptr;
         }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits
+        getTypes(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
     };
 
     /**
-     * IFactoryDenseComposite: Composite for densely populated nodes
+     * IFactoryMatchComposite: a single child, reached when the opcode matches a fixed
+     * mask/value. The trie optimizer builds these from chains of single-child dense nodes
      */
     template <typename InstType, typename AnnotationType>
-    class IFactoryDenseComposite : public IFactoryIF<InstType, AnnotationType>
+    class IFactoryMatchComposite : public IFactoryIF<InstType, AnnotationType>
     {
       public:
-        explicit IFactoryDenseComposite(const Field & f) : field_(f.clone())
+        using NodePtr = typename IFactoryIF<InstType, AnnotationType>::PtrType;
+
+        IFactoryMatchComposite(const Opcode mask, const Opcode value, const NodePtr & child) :
+            mask_(mask),
+            value_(value),
+            child_(mavis::utils::notNull(child))
         {
-            itable_.reset(
-                new typename IFactoryIF<InstType, AnnotationType>::PtrType[field_->getSize()]);
-            for (uint32_t i = 0; i < field_->getSize(); ++i)
-            {
-                itable_[i] = nullptr;
-            }
         }
 
-        ~IFactoryDenseComposite() = default;
+        std::string getName() const override { return "<Match>"; }
 
-        std::string getName() const override { return field_->getName(); }
+        Opcode getMask() const { return mask_; }
 
-        const Field* getField() const override { return field_; }
+        Opcode getValue() const { return value_; }
 
-        typename IFactoryIF<InstType, AnnotationType>::PtrType getDefault() const override
-        {
-            return default_;
-        }
+        const NodePtr & getChild() const { return child_; }
 
-        typename IFactoryIF<InstType, AnnotationType>::PtrType
-        getNode(const Opcode istencil) override
+        NodePtr getNode(const Opcode istencil) override
         {
-            const uint32_t index = field_->extract(istencil);
-            return itable_[index];
+            return ((istencil & mask_) == value_) ? child_ : nullptr;
         }
 
-        void
-        addIFactory(const Opcode istencil,
-                    const typename IFactoryIF<InstType, AnnotationType>::PtrType & node) override
+        NodePtr getDefault() const override { return nullptr; }
+
+        typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
+        getInfo(Opcode icode) override
         {
-            const uint32_t index = field_->extract(istencil);
-            itable_[index] = node;
+            if ((icode & mask_) == value_)
+            {
+                return child_->getInfo(icode);
+            }
+            throw UnknownOpcode(icode);
         }
 
-        void addDefaultIFactory(
-            const typename IFactoryIF<InstType, AnnotationType>::PtrType & node) override
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode icode) override
         {
-            if (default_ != nullptr) [[unlikely]]
+            if ((icode & mask_) == value_)
             {
-                throw std::runtime_error("default already assigned");
+                return child_->getTypes(icode);
             }
-            default_ = node;
+            throw UnknownOpcode(icode);
         }
 
-#if 0
-    virtual typename InstType::PtrType makeInst(Opcode icode) {
-        uint32_t index = field_->extract(icode);
-        if (itable_[index] != nullptr) {
-            return itable_[index]->makeInst(icode);
-        } else if (default_ != nullptr) {
-            return default_->makeInst(icode);
-        } else {
-            return nullptr;
+        NodePtr optimize(const NodePtr & self) override
+        {
+            child_ = child_->optimize(child_);
+            return self;
         }
-    }
-#endif
 
-        typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
-        getInfo(Opcode icode) override
+        void gatherStats(TrieStats & stats, const uint32_t depth) const override
         {
-            const uint32_t index = field_->extract(icode);
-            if (itable_[index] != nullptr)
-            {
-                // Try the specific nodes first, if we fail to decode,
-                // then try the default (if it exists)
-                typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType iptr = nullptr;
-                try
-                {
-                    iptr = itable_[index]->getInfo(icode);
-                }
-                catch (const UnknownOpcode & ex)
-                {
-                    if (default_ != nullptr)
-                    {
-                        return default_->getInfo(icode);
-                    }
-                    else
-                    {
-                        // rethrow
-                        throw;
-                    }
-                }
-                return iptr;
-                // return itable_[index]->getInfo(icode);
-            }
-            else if (default_ != nullptr)
-            {
-                return default_->getInfo(icode);
-            }
-            else
-            {
-                throw UnknownOpcode(icode);
-            }
+            stats.addNode(depth);
+            ++stats.num_match;
+            child_->gatherStats(stats, depth + 1);
         }
 
-        void flushCaches() override
+        typename IFactoryIF<InstType, AnnotationType>::NodeView getView() const override
         {
-            for (uint32_t i = 0; i < field_->getSize(); ++i)
+            typename IFactoryIF<InstType, AnnotationType>::NodeView view;
+            view.kind = IFactoryIF<InstType, AnnotationType>::NodeView::Kind::MATCH;
+            view.mask = mask_;
+            view.value = value_;
+            view.children.emplace_back(0, child_);
+            return view;
+        }
+
+        void flushCaches() override { child_->flushCaches(); }
+
+        void print(std::ostream & os, const uint32_t level = 0) const override
+        {
+            std::ios_base::fmtflags os_state(os.flags());
+            os << "IFactoryMatchComposite::mask=0x" << std::hex << mask_ << ", value=0x" << value_
+               << std::endl;
+            for (uint32_t j = 0; j < level + 1; ++j)
+            {
+                os << "|\t";
+            }
+            os << "[match]: ";
+            child_->print(os, level + 1);
+            os.flags(os_state);
+        }
+
+      private:
+        const Opcode mask_;
+        const Opcode value_;
+        NodePtr child_;
+
+        const Field* getField() const override
+        {
+            throw std::runtime_error("Unimplemented");
+            return nullptr;
+        }
+
+        Opcode getStencil() const override { return 0; };
+
+        void addIFactory(const Opcode, const NodePtr &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
+
+        void addIFactory(const std::string &, const Opcode, const NodePtr &,
+                         const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
+
+        void addDefaultIFactory(const NodePtr &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
+        getInfo(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+            return nullptr;
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits
+        getTypes(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
+    };
+
+    /**
+     * IFactorySparseFlatComposite: sparsely populated field, as a sorted array of (index, child)
+     * pairs. Lookup behaves exactly like IFactoryDenseComposite (including falling back to the
+     * default when a child does not know the opcode). The trie optimizer builds these from dense
+     * nodes with low occupancy
+     */
+    template <typename InstType, typename AnnotationType>
+    class IFactorySparseFlatComposite : public IFactoryIF<InstType, AnnotationType>
+    {
+      public:
+        using NodePtr = typename IFactoryIF<InstType, AnnotationType>::PtrType;
+
+        struct Entry
+        {
+            uint32_t index;
+            NodePtr factory;
+        };
+
+        // entries must be sorted by index
+        IFactorySparseFlatComposite(const Field & f, std::vector<Entry> && entries,
+                                    const NodePtr & dflt) :
+            field_(f.clone()),
+            entries_(std::move(entries)),
+            default_(dflt)
+        {
+        }
+
+        std::string getName() const override { return field_->getName(); }
+
+        const Field* getField() const override { return field_.get(); }
+
+        NodePtr getNode(const Opcode istencil) override
+        {
+            const Entry* entry = find_(field_->extract(istencil));
+            return (entry != nullptr) ? entry->factory : nullptr;
+        }
+
+        NodePtr getDefault() const override { return default_; }
+
+        typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
+        getInfo(Opcode icode) override
+        {
+            const Entry* entry = find_(field_->extract(icode));
+            if (entry != nullptr)
+            {
+                try
+                {
+                    return entry->factory->getInfo(icode);
+                }
+                catch (const UnknownOpcode & ex)
+                {
+                    if (default_ != nullptr)
+                    {
+                        return default_->getInfo(icode);
+                    }
+                    throw;
+                }
+            }
+            else if (default_ != nullptr)
+            {
+                return default_->getInfo(icode);
+            }
+            throw UnknownOpcode(icode);
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode icode) override
+        {
+            const Entry* entry = find_(field_->extract(icode));
+            if (entry != nullptr)
+            {
+                try
+                {
+                    return entry->factory->getTypes(icode);
+                }
+                catch (const UnknownOpcode & ex)
+                {
+                    if (default_ != nullptr)
+                    {
+                        return default_->getTypes(icode);
+                    }
+                    throw;
+                }
+            }
+            else if (default_ != nullptr)
+            {
+                return default_->getTypes(icode);
+            }
+            throw UnknownOpcode(icode);
+        }
+
+        NodePtr optimize(const NodePtr & self) override
+        {
+            for (auto & entry : entries_)
+            {
+                entry.factory = entry.factory->optimize(entry.factory);
+            }
+            if (default_ != nullptr)
+            {
+                default_ = default_->optimize(default_);
+            }
+            return self;
+        }
+
+        void gatherStats(TrieStats & stats, const uint32_t depth) const override
+        {
+            stats.addNode(depth);
+            ++stats.num_sparse;
+            stats.num_table_slots += entries_.size();
+            for (const auto & entry : entries_)
+            {
+                entry.factory->gatherStats(stats, depth + 1);
+            }
+            if (default_ != nullptr)
+            {
+                default_->gatherStats(stats, depth + 1);
+            }
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::NodeView getView() const override
+        {
+            typename IFactoryIF<InstType, AnnotationType>::NodeView view;
+            view.kind = IFactoryIF<InstType, AnnotationType>::NodeView::Kind::FIELD;
+            view.field = field_.get();
+            for (const auto & entry : entries_)
+            {
+                view.children.emplace_back(entry.index, entry.factory);
+            }
+            view.dflt = default_;
+            return view;
+        }
+
+        void flushCaches() override
+        {
+            for (const auto & entry : entries_)
+            {
+                entry.factory->flushCaches();
+            }
+            if (default_ != nullptr)
+            {
+                default_->flushCaches();
+            }
+        }
+
+        void print(std::ostream & os, const uint32_t level = 0) const override
+        {
+            std::ios_base::fmtflags os_state(os.flags());
+            os << "IFactorySparseFlatComposite::Field " << field_->getName() << std::endl;
+            for (const auto & entry : entries_)
+            {
+                for (uint32_t j = 0; j < level + 1; ++j)
+                {
+                    os << "|\t";
+                }
+                os << "[" << std::hex << entry.index << "]: ";
+                entry.factory->print(os, level + 1);
+            }
+
+            if (default_ != nullptr)
+            {
+                for (uint32_t j = 0; j < level + 1; ++j)
+                {
+                    os << "|\t";
+                }
+                os << "[default]: ";
+                default_->print(os, level + 1);
+            }
+            os.flags(os_state);
+        }
+
+      private:
+        std::unique_ptr<Field> field_;
+        std::vector<Entry> entries_;
+        NodePtr default_;
+
+        const Entry* find_(const uint32_t index) const
+        {
+            const auto itr =
+                std::lower_bound(entries_.begin(), entries_.end(), index,
+                                 [](const Entry & entry, uint32_t idx) { return entry.index < idx; });
+            return ((itr != entries_.end()) && (itr->index == index)) ? &(*itr) : nullptr;
+        }
+
+        Opcode getStencil() const override { return 0; };
+
+        void addIFactory(const Opcode, const NodePtr &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
+
+        void addIFactory(const std::string &, const Opcode, const NodePtr &,
+                         const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
+
+        void addDefaultIFactory(const NodePtr &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
+        getInfo(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+            return nullptr;
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits
+        getTypes(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
+    };
+
+    /**
+     * IFactoryDenseComposite: Composite for densely populated nodes
+     */
+    template <typename InstType, typename AnnotationType>
+    class IFactoryDenseComposite : public IFactoryIF<InstType, AnnotationType>
+    {
+      public:
+        explicit IFactoryDenseComposite(const Field & f) : field_(f.clone())
+        {
+            itable_.reset(
+                new typename IFactoryIF<InstType, AnnotationType>::PtrType[field_->getSize()]);
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
+            {
+                itable_[i] = nullptr;
+            }
+        }
+
+        ~IFactoryDenseComposite() = default;
+
+        std::string getName() const override { return field_->getName(); }
+
+        const Field* getField() const override { return field_; }
+
+        typename IFactoryIF<InstType, AnnotationType>::PtrType getDefault() const override
+        {
+            return default_;
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::PtrType
+        getNode(const Opcode istencil) override
+        {
+            const uint32_t index = field_->extract(istencil);
+            return itable_[index];
+        }
+
+        void
+        addIFactory(const Opcode istencil,
+                    const typename IFactoryIF<InstType, AnnotationType>::PtrType & node) override
+        {
+            const uint32_t index = field_->extract(istencil);
+            itable_[index] = node;
+        }
+
+        void addDefaultIFactory(
+            const typename IFactoryIF<InstType, AnnotationType>::PtrType & node) override
+        {
+            if (default_ != nullptr) [[unlikely]]
+            {
+                throw std::runtime_error("default already assigned");
+            }
+            default_ = node;
+        }
+
+#if 0
+    virtual typename InstType::PtrType makeInst(Opcode icode) {
+        uint32_t index = field_->extract(icode);
+        if (itable_[index] != nullptr) {
+            return itable_[index]->makeInst(icode);
+        } else if (default_ != nullptr) {
+            return default_->makeInst(icode);
+        } else {
+            return nullptr;
+        }
+    }
+#endif
+
+        typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
+        getInfo(Opcode icode) override
+        {
+            const uint32_t index = field_->extract(icode);
+            if (itable_[index] != nullptr)
+            {
+                // Try the specific nodes first, if we fail to decode,
+                // then try the default (if it exists)
+                typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType iptr = nullptr;
+                try
+                {
+                    iptr = itable_[index]->getInfo(icode);
+                }
+                catch (const UnknownOpcode & ex)
+                {
+                    if (default_ != nullptr)
+                    {
+                        return default_->getInfo(icode);
+                    }
+                    else
+                    {
+                        // rethrow
+                        throw;
+                    }
+                }
+                return iptr;
+                // return itable_[index]->getInfo(icode);
+            }
+            else if (default_ != nullptr)
+            {
+                return default_->getInfo(icode);
+            }
+            else
+            {
+                throw UnknownOpcode(icode);
+            }
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode icode) override
+        {
+            const uint32_t index = field_->extract(icode);
+            if (itable_[index] != nullptr)
+            {
+                // Same fallback to the default as getInfo()
+                try
+                {
+                    return itable_[index]->getTypes(icode);
+                }
+                catch (const UnknownOpcode & ex)
+                {
+                    if (default_ != nullptr)
+                    {
+                        return default_->getTypes(icode);
+                    }
+                    throw;
+                }
+            }
+            else if (default_ != nullptr)
+            {
+                return default_->getTypes(icode);
+            }
+            throw UnknownOpcode(icode);
+        }
+
+        /**
+         * \brief Trie optimizer (see IFactoryIF::optimize()). After optimizing the children:
+         * - a node with only a default (an ignored field) is replaced by its default
+         * - a node with a single child and no default becomes a mask/value match, folded into
+         *   the child if the child is a match as well
+         * - a node whose children are all dense nodes on the same field (no defaults at either
+         *   level) is merged with them into one table indexed by both fields, if that does not
+         *   grow the tables
+         * - a sparsely occupied node becomes a sorted array of its children
+         */
+        typename IFactoryIF<InstType, AnnotationType>::PtrType
+        optimize(const typename IFactoryIF<InstType, AnnotationType>::PtrType & self) override
+        {
+            uint32_t occupied = 0;
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
+            {
+                if (itable_[i] != nullptr)
+                {
+                    itable_[i] = itable_[i]->optimize(itable_[i]);
+                    ++occupied;
+                }
+            }
+            if (default_ != nullptr)
+            {
+                default_ = default_->optimize(default_);
+            }
+
+            if (occupied == 0)
+            {
+                return (default_ != nullptr) ? default_ : self;
+            }
+            if (default_ == nullptr)
+            {
+                if (occupied == 1)
+                {
+                    if (auto match = makeMatch_(); match != nullptr)
+                    {
+                        return match;
+                    }
+                }
+                if (auto merged = mergeChildren_(occupied); merged != nullptr)
+                {
+                    return merged->selectLayout_(merged);
+                }
+            }
+            return selectLayout_(self);
+        }
+
+        void gatherStats(TrieStats & stats, const uint32_t depth) const override
+        {
+            stats.addNode(depth);
+            ++stats.num_dense;
+            stats.num_table_slots += field_->getSize();
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
+            {
+                if (itable_[i] != nullptr)
+                {
+                    itable_[i]->gatherStats(stats, depth + 1);
+                }
+            }
+            if (default_ != nullptr)
+            {
+                default_->gatherStats(stats, depth + 1);
+            }
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::NodeView getView() const override
+        {
+            typename IFactoryIF<InstType, AnnotationType>::NodeView view;
+            view.kind = IFactoryIF<InstType, AnnotationType>::NodeView::Kind::FIELD;
+            view.field = field_;
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
+            {
+                if (itable_[i] != nullptr)
+                {
+                    view.children.emplace_back(i, itable_[i]);
+                }
+            }
+            view.dflt = default_;
+            return view;
+        }
+
+        void flushCaches() override
+        {
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
             {
                 if (itable_[i] != nullptr)
                 {
@@ -715,44 +1415,171 @@ namespace mavis
 
             if (default_ != nullptr)
             {
-                default_->flushCaches();
+                default_->flushCaches();
+            }
+        }
+
+        void print(std::ostream & os, const uint32_t level = 0) const override
+        {
+            std::ios_base::fmtflags os_state(os.flags());
+            os << "IFactoryDenseComposite::Field " << field_->getName() << std::endl;
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
+            {
+                if (itable_[i] != nullptr)
+                {
+                    for (uint32_t j = 0; j < level + 1; ++j)
+                    {
+                        os << "|\t";
+                    }
+                    os << "[" << std::hex << i << "]: ";
+                    itable_[i]->print(os, level + 1);
+                }
+            }
+
+            if (default_ != nullptr)
+            {
+                for (uint32_t j = 0; j < level + 1; ++j)
+                {
+                    os << "|\t";
+                }
+                os << "[default]: ";
+                default_->print(os, level + 1);
+            }
+            os.flags(os_state);
+        }
+
+      private:
+        typename IFactoryIF<InstType, AnnotationType>::PtrType default_ = nullptr;
+        Field* field_;
+        std::unique_ptr<typename IFactoryIF<InstType, AnnotationType>::PtrType[]> itable_;
+
+        // Trie optimizer tuning
+        static constexpr uint32_t MAX_MERGED_SIZE = 256;   // Largest table built by merging
+        static constexpr uint32_t MIN_SPARSE_SIZE = 16;    // Smaller tables always stay dense
+        static constexpr uint32_t SPARSE_OCCUPANCY = 8;    // Sparse if at most 1/8 occupied
+
+        // Whether the node's field is a single contiguous bit range (i.e. a plain Field)
+        bool isPlainField_() const { return typeid(*field_) == typeid(Field); }
+
+        // Opcode bits that select table entry index (plain fields only)
+        Opcode placeIndex_(const uint32_t index) const
+        {
+            return static_cast<Opcode>(index) << __builtin_ctzll(field_->getShiftedMask());
+        }
+
+        // Replace a single-child node with a mask/value match (nullptr if not possible)
+        typename IFactoryIF<InstType, AnnotationType>::PtrType makeMatch_() const
+        {
+            if (!isPlainField_())
+            {
+                return nullptr;
+            }
+            uint32_t index = 0;
+            while (itable_[index] == nullptr)
+            {
+                ++index;
+            }
+            Opcode mask = field_->getShiftedMask();
+            Opcode value = placeIndex_(index);
+            typename IFactoryIF<InstType, AnnotationType>::PtrType child = itable_[index];
+
+            using MatchType = IFactoryMatchComposite<InstType, AnnotationType>;
+            if (const auto child_match = std::dynamic_pointer_cast<MatchType>(child);
+                (child_match != nullptr) && ((child_match->getMask() & mask) == 0))
+            {
+                mask |= child_match->getMask();
+                value |= child_match->getValue();
+                child = child_match->getChild();
+            }
+            return std::make_shared<MatchType>(mask, value, child);
+        }
+
+        // Merge this node and its dense children into one table (nullptr if not possible)
+        std::shared_ptr<IFactoryDenseComposite> mergeChildren_(const uint32_t occupied) const
+        {
+            if (!isPlainField_())
+            {
+                return nullptr;
+            }
+            const Field* child_field = nullptr;
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
+            {
+                if (itable_[i] == nullptr)
+                {
+                    continue;
+                }
+                const auto child = std::dynamic_pointer_cast<IFactoryDenseComposite>(itable_[i]);
+                if ((child == nullptr) || (child->default_ != nullptr) || !child->isPlainField_())
+                {
+                    return nullptr;
+                }
+                if (child_field == nullptr)
+                {
+                    child_field = child->field_;
+                }
+                else if (child->field_->getShiftedMask() != child_field->getShiftedMask())
+                {
+                    return nullptr;
+                }
+            }
+            if ((child_field->getShiftedMask() & field_->getShiftedMask()) != 0)
+            {
+                return nullptr;
+            }
+
+            const uint64_t merged_size = uint64_t(field_->getSize()) * child_field->getSize();
+            if ((merged_size > MAX_MERGED_SIZE)
+                || (merged_size > (field_->getSize() + occupied * child_field->getSize())))
+            {
+                return nullptr;
+            }
+
+            // The child field supplies the low order bits of the merged index
+            auto merged = std::make_shared<IFactoryDenseComposite>(
+                ConcatField<2>(*child_field, *field_));
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
+            {
+                if (itable_[i] == nullptr)
+                {
+                    continue;
+                }
+                const auto child = std::static_pointer_cast<IFactoryDenseComposite>(itable_[i]);
+                for (uint32_t j = 0; j < child_field->getSize(); ++j)
+                {
+                    merged->itable_[(i << child_field->getLength()) | j] = child->itable_[j];
+                }
             }
+            return merged;
         }
 
-        void print(std::ostream & os, const uint32_t level = 0) const override
+        // Keep the dense table, or switch to a sparse one if few entries are used
+        typename IFactoryIF<InstType, AnnotationType>::PtrType
+        selectLayout_(const typename IFactoryIF<InstType, AnnotationType>::PtrType & self) const
         {
-            std::ios_base::fmtflags os_state(os.flags());
-            os << "IFactoryDenseComposite::Field " << field_->getName() << std::endl;
+            uint32_t occupied = 0;
             for (uint32_t i = 0; i < field_->getSize(); ++i)
             {
-                if (itable_[i] != nullptr)
-                {
-                    for (uint32_t j = 0; j < level + 1; ++j)
-                    {
-                        os << "|\t";
-                    }
-                    os << "[" << std::hex << i << "]: ";
-                    itable_[i]->print(os, level + 1);
-                }
+                occupied += (itable_[i] != nullptr) ? 1 : 0;
+            }
+            if ((field_->getSize() < MIN_SPARSE_SIZE)
+                || ((occupied * SPARSE_OCCUPANCY) > field_->getSize()))
+            {
+                return self;
             }
 
-            if (default_ != nullptr)
+            using SparseType = IFactorySparseFlatComposite<InstType, AnnotationType>;
+            std::vector<typename SparseType::Entry> entries;
+            entries.reserve(occupied);
+            for (uint32_t i = 0; i < field_->getSize(); ++i)
             {
-                for (uint32_t j = 0; j < level + 1; ++j)
+                if (itable_[i] != nullptr)
                 {
-                    os << "|\t";
+                    entries.push_back({i, itable_[i]});
                 }
-                os << "[default]: ";
-                default_->print(os, level + 1);
             }
-            os.flags(os_state);
+            return std::make_shared<SparseType>(*field_, std::move(entries), default_);
         }
 
-      private:
-        typename IFactoryIF<InstType, AnnotationType>::PtrType default_ = nullptr;
-        Field* field_;
-        std::unique_ptr<typename IFactoryIF<InstType, AnnotationType>::PtrType[]> itable_;
-
         Opcode getStencil() const override { return 0; };
 
         void addIFactory(const std::string &, const Opcode,
@@ -768,6 +1595,12 @@ namespace mavis
             throw std::runtime_error("Unimplemented");
             return nullptr;
         }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits
+        getTypes(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
     };
 
     /**
@@ -865,6 +1698,55 @@ namespace mavis
             }
         }
 
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode icode) override
+        {
+            const uint32_t index = selector_(field_->extract(icode));
+            if (itable_[index] != nullptr)
+            {
+                return itable_[index]->getTypes(icode);
+            }
+            else if (default_ != nullptr)
+            {
+                return default_->getTypes(icode);
+            }
+            throw UnknownOpcode(icode);
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::PtrType
+        optimize(const typename IFactoryIF<InstType, AnnotationType>::PtrType & self) override
+        {
+            for (uint32_t i = 0; i < tsize_; ++i)
+            {
+                if (itable_[i] != nullptr)
+                {
+                    itable_[i] = itable_[i]->optimize(itable_[i]);
+                }
+            }
+            if (default_ != nullptr)
+            {
+                default_ = default_->optimize(default_);
+            }
+            return self;
+        }
+
+        void gatherStats(TrieStats & stats, const uint32_t depth) const override
+        {
+            stats.addNode(depth);
+            ++stats.num_dense;
+            stats.num_table_slots += tsize_;
+            for (uint32_t i = 0; i < tsize_; ++i)
+            {
+                if (itable_[i] != nullptr)
+                {
+                    itable_[i]->gatherStats(stats, depth + 1);
+                }
+            }
+            if (default_ != nullptr)
+            {
+                default_->gatherStats(stats, depth + 1);
+            }
+        }
+
         void flushCaches() override
         {
             for (uint32_t i = 0; i < tsize_; ++i)
@@ -933,6 +1815,12 @@ namespace mavis
             throw std::runtime_error("Unimplemented");
             return nullptr;
         }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits
+        getTypes(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
     };
 
     /**
@@ -944,7 +1832,14 @@ namespace mavis
       public:
         typedef std::function<bool(uint32_t)> MatcherType;
 
-        IFactoryMatchListComposite(const Field & f, std::initializer_list<MatcherType> lambdas) :
+        /**
+         * \param f Field whose value is passed to the matchers
+         * \param lambdas Matchers, tried in order
+         * \param lut_mask Bits of the field value the matchers depend on. If non-zero, decode
+         * selects the matcher with a lookup table on those bits instead of calling the matchers
+         */
+        IFactoryMatchListComposite(const Field & f, std::initializer_list<MatcherType> lambdas,
+                                   const uint32_t lut_mask = 0) :
             field_(f.clone())
         {
             uint32_t i = 0;
@@ -953,6 +1848,10 @@ namespace mavis
                 itable_[i] = {matcher, nullptr};
                 ++i;
             }
+            if (lut_mask != 0)
+            {
+                buildLookup_(lut_mask);
+            }
         }
 
         ~IFactoryMatchListComposite() = default;
@@ -1022,28 +1921,73 @@ namespace mavis
 
         typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
         getInfo(Opcode icode) override
+        {
+            return findChild_(icode)->getInfo(icode);
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode icode) override
+        {
+            return findChild_(icode)->getTypes(icode);
+        }
+
+        typename IFactoryIF<InstType, AnnotationType>::PtrType
+        optimize(const typename IFactoryIF<InstType, AnnotationType>::PtrType & self) override
         {
             for (auto & me : itable_)
             {
-                if (me.matcher(field_->extract(icode)))
+                if (me.factory != nullptr)
                 {
-                    if (me.factory != nullptr)
-                    {
-                        return me.factory->getInfo(icode);
-                    }
-                    else if (default_ != nullptr)
-                    {
-                        return default_->getInfo(icode);
-                    }
-                    else
-                    {
-                        throw UnknownOpcode(icode);
-                        // return nullptr;
-                    }
+                    me.factory = me.factory->optimize(me.factory);
                 }
             }
-            throw UnknownOpcode(icode);
-            // return nullptr;
+            if (default_ != nullptr)
+            {
+                default_ = default_->optimize(default_);
+            }
+            return self;
+        }
+
+        void gatherStats(TrieStats & stats, const uint32_t depth) const override
+        {
+            stats.addNode(depth);
+            for (const auto & me : itable_)
+            {
+                if (me.factory != nullptr)
+                {
+                    me.factory->gatherStats(stats, depth + 1);
+                }
+            }
+            if (default_ != nullptr)
+            {
+                default_->gatherStats(stats, depth + 1);
+            }
+        }
+
+        /**
+         * \brief Only a match list with a lookup table describes itself (its matchers are opaque,
+         * but the table captures them). The view's select() refers to this node
+         */
+        typename IFactoryIF<InstType, AnnotationType>::NodeView getView() const override
+        {
+            typename IFactoryIF<InstType, AnnotationType>::NodeView view;
+            if (lut_.empty())
+            {
+                return view;
+            }
+            view.kind = IFactoryIF<InstType, AnnotationType>::NodeView::Kind::MATCH_LIST;
+            const uint32_t field_shift = __builtin_ctzll(field_->getShiftedMask());
+            for (const auto & run : lut_runs_)
+            {
+                view.mask |= static_cast<Opcode>(run.mask) << (run.shift + field_shift);
+            }
+            for (uint32_t i = 0; i < TableSize; ++i)
+            {
+                view.children.emplace_back(i, itable_[i].factory);
+            }
+            view.dflt = default_;
+            view.select = [this](Opcode icode)
+            { return static_cast<uint32_t>(lut_[lookupIndex_(field_->extract(icode))]); };
+            return view;
         }
 
         void flushCaches() override
@@ -1106,6 +2050,111 @@ namespace mavis
         std::unique_ptr<Field> field_;
         std::array<MatchEntry, TableSize> itable_;
 
+        // Matcher lookup table (see buildLookup_()): the field value bits under the lookup mask,
+        // gathered run by run, index the table, which holds the index of the first matcher
+        // accepting that value (TableSize if none)
+        struct LookupRun
+        {
+            uint32_t shift; // Position of the run in the field value
+            uint32_t mask;  // Right justified mask of the run
+            uint32_t pos;   // Position of the run in the table index
+        };
+
+        static constexpr uint32_t MAX_LOOKUP_BITS = 16;
+        std::vector<LookupRun> lut_runs_;
+        std::vector<uint8_t> lut_;
+
+        uint32_t lookupIndex_(const uint64_t value) const
+        {
+            uint32_t index = 0;
+            for (const auto & run : lut_runs_)
+            {
+                index |= ((value >> run.shift) & run.mask) << run.pos;
+            }
+            return index;
+        }
+
+        void buildLookup_(uint32_t lut_mask)
+        {
+            static_assert(TableSize < 0xff, "Too many matchers for the lookup table");
+            uint32_t pos = 0;
+            while (lut_mask != 0)
+            {
+                const uint32_t shift = __builtin_ctz(lut_mask);
+                uint32_t len = 0;
+                while ((shift + len < 32) && ((lut_mask >> (shift + len)) & 1))
+                {
+                    ++len;
+                }
+                const uint32_t mask = (len == 32) ? ~0u : ((1u << len) - 1);
+                lut_runs_.push_back({shift, mask, pos});
+                lut_mask &= ~(mask << shift);
+                pos += len;
+            }
+            if (pos > MAX_LOOKUP_BITS) [[unlikely]]
+            {
+                throw std::invalid_argument("IFactoryMatchListComposite: lookup mask too wide");
+            }
+
+            lut_.resize(1ull << pos);
+            for (uint32_t index = 0; index < lut_.size(); ++index)
+            {
+                uint32_t value = 0;
+                for (const auto & run : lut_runs_)
+                {
+                    value |= ((index >> run.pos) & run.mask) << run.shift;
+                }
+                lut_[index] = TableSize;
+                for (uint32_t i = 0; i < TableSize; ++i)
+                {
+                    if (itable_[i].matcher && itable_[i].matcher(value))
+                    {
+                        lut_[index] = i;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // The child that decodes icode: the factory of the first matching entry (the default if
+        // that entry has none)
+        const typename IFactoryIF<InstType, AnnotationType>::PtrType &
+        findChild_(Opcode icode) const
+        {
+            if (!lut_.empty())
+            {
+                const uint32_t selected = lut_[lookupIndex_(field_->extract(icode))];
+                if (selected == TableSize)
+                {
+                    throw UnknownOpcode(icode);
+                }
+                return findChild_(itable_[selected], icode);
+            }
+
+            for (const auto & me : itable_)
+            {
+                if (me.matcher(field_->extract(icode)))
+                {
+                    return findChild_(me, icode);
+                }
+            }
+            throw UnknownOpcode(icode);
+        }
+
+        const typename IFactoryIF<InstType, AnnotationType>::PtrType &
+        findChild_(const MatchEntry & me, Opcode icode) const
+        {
+            if (me.factory != nullptr)
+            {
+                return me.factory;
+            }
+            else if (default_ != nullptr)
+            {
+                return default_;
+            }
+            throw UnknownOpcode(icode);
+        }
+
         Opcode getStencil() const override { return 0; };
 
         void addIFactory(const std::string &, const Opcode,
@@ -1121,6 +2170,12 @@ namespace mavis
             throw std::runtime_error("Unimplemented");
             return nullptr;
         }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits
+        getTypes(const std::string &, Opcode, const ExtractorIF::PtrType &) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
     };
 
     /**
@@ -1192,6 +2247,18 @@ namespace mavis
 
         typedef Stash<Opcode, StashEntry, 7> ExtractionStashType;
 
+        /**
+         * \brief Everything this factory knows about one of its instruction variants (keyed by
+         * mnemonic), so that a single lookup yields the UID, metadata, and annotation
+         */
+        struct InstructionVariant
+        {
+            InstructionUniqueID uid = INVALID_UID;
+            InstMetaData::PtrType meta;             // nullptr: use the factory's metadata
+            typename AnnotationType::PtrType anno;
+            bool has_anno = false;                  // anno may legitimately be nullptr
+        };
+
       public:
         IFactory(const std::string & name, const Opcode stencil,
                  const InstMetaData::PtrType & meta) :
@@ -1250,17 +2317,15 @@ namespace mavis
             // Stash miss...
             if (entry == nullptr)
             {
+                // One lookup resolves the UID, metadata, and annotation of the variant
+                const InstructionVariant* variant = findVariant_(mnemonic);
                 std::string use_mnemonic = mnemonic;
                 ExtractorIF::PtrType use_extractor = extractor;
-                InstMetaData::PtrType use_meta = getMeta_(mnemonic);
+                InstMetaData::PtrType use_meta = getMeta_(variant);
                 // TODO: Do we need to support instruction variants for disassembly?
                 DisassemblerIF::PtrType use_dasm = dasm_;
-                InstructionUniqueID use_uid =
-                    getInstructionUID_(mnemonic); // TODO: lookup work may be wasted
-                // typename AnnotationType::PtrType use_anno = getAnnotation_(mnemonic);     //
-                // TODO: lookup work may be wasted
-                typename AnnotationType::PtrType use_anno =
-                    findAnnotation_(mnemonic); // TODO: lookup work may be wasted
+                InstructionUniqueID use_uid = getInstructionUID_(variant);
+                typename AnnotationType::PtrType use_anno = findAnnotation_(variant);
 
                 const typename Overlay<InstType, AnnotationType>::PtrType olay =
                     findMatchingOverlay_(icode);
@@ -1287,24 +2352,63 @@ namespace mavis
 
                 const StashEntry* new_entry =
                     stash_->allocate(icode, icode,
-                                     std::make_shared<DecodedInstructionInfo>(
+                                     makeShared<DecodedInstructionInfo>(
                                          use_mnemonic, use_uid, use_extractor, use_meta, icode),
                                      use_extractor, use_meta, use_dasm, use_anno);
-                optr = std::make_shared<OpcodeInfo>(icode, new_entry->dii, use_extractor,
-                                                    new_entry->meta, use_dasm);
-                return std::make_shared<
+                optr = makeShared<OpcodeInfo>(icode, new_entry->dii, use_extractor,
+                                              new_entry->meta, use_dasm);
+                return makeShared<
                     typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo>(optr,
                                                                                  new_entry->anno);
             }
             else
             {
-                optr = std::make_shared<OpcodeInfo>(icode, entry->dii, entry->extractor,
-                                                    entry->meta, entry->dasm);
-                return std::make_shared<
+                optr = makeShared<OpcodeInfo>(icode, entry->dii, entry->extractor,
+                                              entry->meta, entry->dasm);
+                return makeShared<
                     typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo>(optr, entry->anno);
             }
         }
 
+        /**
+         * \brief getTypes: the type bits getInfo() would report for the instruction, resolved
+         * from the stash if it holds icode, else from the variant's (or matching overlay's)
+         * metadata and the extractor's register masks. Builds nothing and leaves the stash alone
+         */
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits
+        getTypes(const std::string & mnemonic, Opcode icode,
+                 const ExtractorIF::PtrType & extractor) override
+        {
+            if (const StashEntry* entry = stash_->lookup(icode); entry != nullptr)
+            {
+                return {entry->meta->getInstType(), entry->dii->getExtInstType()};
+            }
+
+            ExtractorIF::PtrType use_extractor = extractor;
+            InstMetaData::PtrType use_meta = getMeta_(findVariant_(mnemonic));
+
+            // Same overlay selection as getInfo()
+            const typename Overlay<InstType, AnnotationType>::PtrType olay =
+                findMatchingOverlay_(icode);
+            if ((olay != nullptr) && (olay->getBaseMnemonic() == mnemonic))
+            {
+                if (olay->getExtractor() != nullptr)
+                {
+                    use_extractor = olay->getExtractor();
+                    if (use_extractor->isIllop(icode))
+                    {
+                        throw IllegalOpcode(olay->getMnemonic(), icode);
+                    }
+                }
+                use_meta = olay->getMetaData();
+            }
+
+            return {use_meta->getInstType(),
+                    DecodedInstructionInfo::computeExtInstType(use_meta,
+                                                               use_extractor->getSourceRegs(icode),
+                                                               use_extractor->getDestRegs(icode))};
+        }
+
         /**
          * \brief Version of getInfo which does not use the DecodedInstInfo cache. This is called by
          * DTable::makeInstDirectly (i.e. no opcode supplied)
@@ -1316,26 +2420,53 @@ namespace mavis
         typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
         getInfoBypassCache(const std::string & mnemonic, const ExtractorIF::PtrType & extractor)
         {
-            const auto meta = getMeta_(mnemonic);
+            const InstructionVariant* variant = findVariant_(mnemonic);
+            return getInfoBypassCache(mnemonic, getInstructionUID_(variant), getMeta_(variant),
+                                      findAnnotation_(variant), extractor);
+        }
 
+        /**
+         * \brief Version of getInfoBypassCache for a variant already resolved by the builder
+         * (i.e. by UID), which skips the variant lookup by mnemonic
+         */
+        typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType
+        getInfoBypassCache(const std::string & mnemonic, const InstructionUniqueID uid,
+                           const InstMetaData::PtrType & meta,
+                           const typename AnnotationType::PtrType & anno,
+                           const ExtractorIF::PtrType & extractor) const
+        {
             const DecodedInstructionInfo::PtrType & new_dii =
-                std::make_shared<DecodedInstructionInfo>(mnemonic, getInstructionUID_(mnemonic),
-                                                         extractor, meta, Opcode(0));
+                makeShared<DecodedInstructionInfo>(mnemonic, uid, extractor, meta, Opcode(0));
             OpcodeInfo::PtrType optr =
-                std::make_shared<OpcodeInfo>(Opcode(0), new_dii, extractor, meta, dasm_);
+                makeShared<OpcodeInfo>(Opcode(0), new_dii, extractor, meta, dasm_);
+
+            return makeShared<typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo>(optr,
+                                                                                         anno);
+        }
 
-            // return std::make_shared<typename IFactoryIF<InstType,
-            // AnnotationType>::IFactoryInfo>(optr, getAnnotation_(mnemonic));
-            return std::make_shared<typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo>(
-                optr, findAnnotation_(mnemonic));
+        /**
+         * \brief Resolve everything needed to build the given instruction variant directly, so
+         * that repeated direct builds don't repeat the lookups (see DirectInstHandle)
+         * \param mnemonic
+         * \return
+         */
+        DirectInstHandle<AnnotationType> prepareDirect(const std::string & mnemonic) const
+        {
+            const InstructionVariant* variant = findVariant_(mnemonic);
+            return DirectInstHandle<AnnotationType>(mnemonic, getInstructionUID_(variant),
+                                                    getMeta_(variant), dasm_,
+                                                    findAnnotation_(variant));
         }
 
         void addInstructionVariantAnnotation(const std::string & mnemonic,
                                              const typename AnnotationType::PtrType & anno)
         {
-            if (annotation_map_.find(mnemonic) == annotation_map_.end())
+            InstructionVariant & variant = variants_[mnemonic];
+            if (!variant.has_anno)
             {
-                annotation_map_[mnemonic] = anno;
+                variant.anno = anno;
+                variant.has_anno = true;
+                has_annotations_ = true;
             }
             else
             {
@@ -1347,9 +2478,10 @@ namespace mavis
 
         void addInstructionVariantUID(const std::string & mnemonic, const InstructionUniqueID uid)
         {
-            if (uid_map_.find(mnemonic) == uid_map_.end())
+            InstructionVariant & variant = variants_[mnemonic];
+            if (variant.uid == INVALID_UID)
             {
-                uid_map_[mnemonic] = uid;
+                variant.uid = uid;
             }
 #if 0
         // TODO: Enable this code once we can assure uniqueness
@@ -1382,9 +2514,10 @@ namespace mavis
                                                 const InstMetaData::PtrType & new_meta)
         {
             // Register the combined metadata with the mnemonic
-            if (meta_map_.find(mnemonic) == meta_map_.end())
+            InstructionVariant & variant = variants_[mnemonic];
+            if (variant.meta == nullptr)
             {
-                meta_map_[mnemonic] = new_meta;
+                variant.meta = new_meta;
             }
             else
             {
@@ -1415,10 +2548,56 @@ namespace mavis
             {
                 overlay_list_.push_back(olay);
             }
+
+            std::vector<std::pair<Opcode, Opcode>> rules;
+            rules.reserve(overlay_list_.size());
+            for (const auto & overlay : overlay_list_)
+            {
+                rules.emplace_back(overlay->getMatchMask(), overlay->getMatchValue());
+            }
+            overlay_matcher_.build(rules);
         }
 
         void flushCaches() override { stash_.reset(new ExtractionStashType("ExtractionStash")); }
 
+        typename IFactoryIF<InstType, AnnotationType>::NodeView getView() const override
+        {
+            typename IFactoryIF<InstType, AnnotationType>::NodeView view;
+            view.kind = IFactoryIF<InstType, AnnotationType>::NodeView::Kind::LEAF;
+            return view;
+        }
+
+        /**
+         * \brief UID of an instruction variant (mnemonic) this factory decodes
+         */
+        InstructionUniqueID getVariantUID(const std::string & mnemonic) const
+        {
+            return getInstructionUID_(findVariant_(mnemonic));
+        }
+
+        /**
+         * \brief Metadata of an instruction variant this factory decodes
+         */
+        const InstMetaData::PtrType & getVariantMetaData(const std::string & mnemonic) const
+        {
+            return getMeta_(findVariant_(mnemonic));
+        }
+
+        /**
+         * \brief Annotation of an instruction variant this factory decodes
+         */
+        typename AnnotationType::PtrType getVariantAnnotation(const std::string & mnemonic) const
+        {
+            return findAnnotation_(findVariant_(mnemonic));
+        }
+
+        // Overlays, in the order they are matched (most specific first)
+        const std::vector<typename Overlay<InstType, AnnotationType>::PtrType> &
+        getOverlays() const
+        {
+            return overlay_list_;
+        }
+
         void print(std::ostream & os, const uint32_t) const override
         {
             std::ios_base::fmtflags os_state(os.flags());
@@ -1431,11 +2610,11 @@ namespace mavis
         const Opcode stencil_;   // For debugging
         InstMetaData::PtrType meta_;
         DisassemblerIF::PtrType dasm_;
-        std::map<const std::string, InstructionUniqueID> uid_map_;
-        std::map<const std::string, typename AnnotationType::PtrType> annotation_map_;
-        std::map<const std::string, typename InstMetaData::PtrType> meta_map_;
+        std::unordered_map<std::string, InstructionVariant> variants_;
+        bool has_annotations_ = false;
         std::unique_ptr<ExtractionStashType> stash_;
         std::vector<typename Overlay<InstType, AnnotationType>::PtrType> overlay_list_;
+        MaskMatchTable overlay_matcher_; // overlay_list_ compiled for lookup
 
       protected:
         /**
@@ -1448,34 +2627,45 @@ namespace mavis
          */
         const typename AnnotationType::PtrType findAnnotation_(const std::string & mnemonic) const
         {
-            if (annotation_map_.empty()) [[unlikely]]
+            return findAnnotation_(findVariant_(mnemonic));
+        }
+
+        const typename AnnotationType::PtrType
+        findAnnotation_(const InstructionVariant* variant) const
+        {
+            if (!has_annotations_) [[unlikely]]
             {
                 throw std::runtime_error("Annotation map is empty");
             }
 
-            auto iter = annotation_map_.find(mnemonic);
-            if (iter == annotation_map_.end())
+            if ((variant == nullptr) || !variant->has_anno)
             {
                 // If this mnemonic is an expansion (i.e. compressed instruction), we will
                 // not find it in the annotation map. Compressed/expanded instructions map
                 // to another (existing) factory, and that factory's annotations will be used
                 // instead. For these instructions, return the annotation for this factory name
-                iter = annotation_map_.find(name_);
-                if (iter == annotation_map_.end())
+                const InstructionVariant* factory_variant = findVariant_(name_);
+                if ((factory_variant == nullptr) || !factory_variant->has_anno)
                 {
                     return nullptr; // Annotation not found for mnemonic or factory name
                 }
                 else
                 {
-                    return iter->second; // Annotation found for factory name
+                    return factory_variant->anno; // Annotation found for factory name
                 }
             }
             else
             {
-                return iter->second; // Annotation found for mnemonic
+                return variant->anno; // Annotation found for mnemonic
             }
         }
 
+        const InstructionVariant* findVariant_(const std::string & mnemonic) const
+        {
+            const auto iter = variants_.find(mnemonic);
+            return (iter == variants_.end()) ? nullptr : &iter->second;
+        }
+
 #if 0
     // Custom IFactories (e.g. for non-ISA instructions such as CMOV) should override
     // this method to avoid throwing an exception for a missing annotation
@@ -1491,20 +2681,18 @@ namespace mavis
 
         typename Overlay<InstType, AnnotationType>::PtrType findMatchingOverlay_(Opcode icode) const
         {
-            for (const auto & olay : overlay_list_)
-            {
-                if (olay->isMatch(icode))
-                {
-                    return olay;
-                }
-            }
-            return nullptr;
+            const uint32_t idx = overlay_matcher_.find(icode);
+            return (idx != MaskMatchTable::NO_MATCH) ? overlay_list_[idx] : nullptr;
         }
 
       private:
-        InstructionUniqueID getInstructionUID_(const std::string & mnemonic) const
+        InstructionUniqueID getInstructionUID_(const InstructionVariant* variant) const
         {
-            InstructionUniqueID uid = uid_map_.at(mnemonic);
+            if (variant == nullptr) [[unlikely]]
+            {
+                throw std::out_of_range("No UID registered for instruction variant");
+            }
+            InstructionUniqueID uid = variant->uid;
             if (uid == INVALID_UID) [[unlikely]]
             {
                 throw std::runtime_error("UID is invalid");
@@ -1517,18 +2705,17 @@ namespace mavis
          * metadata, it means there was no instruction variant registered, and we
          * just use the metadata associated with the factory
          *
-         * \param mnemonic
+         * \param variant
          * \return
          */
         // TODO: do we need to support instruction variants for disassemblers?
-        InstMetaData::PtrType getMeta_(const std::string & mnemonic) const
+        const InstMetaData::PtrType & getMeta_(const InstructionVariant* variant) const
         {
-            const auto iter = meta_map_.find(mnemonic);
-            if (iter == meta_map_.end())
+            if ((variant == nullptr) || (variant->meta == nullptr))
             {
                 return meta_;
             }
-            return iter->second;
+            return variant->meta;
         }
 
       private:
@@ -1573,6 +2760,11 @@ namespace mavis
             throw std::runtime_error("Unimplemented");
             return nullptr;
         }
+
+        typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode) override
+        {
+            throw std::runtime_error("Unimplemented");
+        }
     };
 
 } // namespace mavis
@@ -29,7 +29,7 @@ namespace mavis
         //
         // Another way to do help the compiler find base class members is to explicitly de-reference
         // them with "this->". I've used that method for other members in the code below. I've opted
-        // to declare registry_ with "using" here instead, since registry_ is an std::map() and I'm
+        // to declare registry_ with "using" here instead, since registry_ is a hash map and I'm
         // doing index operations on it. The syntax is cleaner for indexing registry_ this way.
         using FactoryBuilderBase<FactoryType, InstType, AnnotationType,
                                  AnnotationTypeAllocator>::registry_;
@@ -57,6 +57,7 @@ namespace mavis
                 einfo_nop, this->findAnnotation("nop", true)));
             const InstructionUniqueID uid_nop = this->registerInst("nop");
             registry_["nop"]->addInstructionVariantUID("nop", uid_nop);
+            registerVariant_(uid_nop, registry_["nop"], "nop");
 
             // TODO: Need a real extraction info object
             InstMetaData::PtrType einfo_cmov(new InstMetaData(InstMetaData::ISA::RV64I));
@@ -71,6 +72,7 @@ namespace mavis
                 einfo_cmov, this->findAnnotation("cmov", true)));
             const InstructionUniqueID uid_cmov = this->registerInst("cmov");
             registry_["cmov"]->addInstructionVariantUID("cmov", uid_cmov);
+            registerVariant_(uid_cmov, registry_["cmov"], "cmov");
         }
 
         /**
@@ -143,6 +145,7 @@ namespace mavis
                 ifact->addInstructionVariantAnnotation(mnemonic, panno);
                 const InstructionUniqueID inst_uid = this->registerInst(mnemonic);
                 ifact->addInstructionVariantUID(mnemonic, inst_uid);
+                registerVariant_(inst_uid, ifact, mnemonic);
             }
             else
             {
@@ -197,6 +200,7 @@ namespace mavis
 
             olay->setBaseMetaData(base_meta);
             olay->setUID(this->registerInst(olay_mnemonic));
+            this->registerOverlay(olay_mnemonic, olay_base_mnemonic, olay->getMetaData());
 
             // Attempt to find the annotation for the overlay.
             // If not found, we use the annotation for the base
@@ -227,9 +231,22 @@ namespace mavis
                 ifact->addInstructionVariantUID(olay_mnemonic, olay->getUID());
                 ifact->registerInstructionVariantMetaData(olay_mnemonic, olay->getMetaData());
                 ifact->addInstructionVariantAnnotation(olay_mnemonic, panno);
+                registerVariant_(olay->getUID(), ifact, olay_mnemonic);
                 registry_[olay_mnemonic] = std::move(ifact);
             }
         }
+
+      private:
+        /**
+         * \brief Record the variant owning uid with the builder, as resolved by its factory
+         */
+        void registerVariant_(const InstructionUniqueID uid,
+                              const typename FactoryType::PtrType & ifact,
+                              const std::string & mnemonic)
+        {
+            this->registerVariant(uid, ifact, ifact->getVariantMetaData(mnemonic),
+                                  ifact->getVariantAnnotation(mnemonic));
+        }
     };
 
 } // namespace mavis
@@ -41,12 +41,21 @@ public:
     typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType getInfo(const std::string& mnemonic,
                                                                                  const ExtractorIF::PtrType& extractor)
     {
-        const ExtractorWrap::PtrType& ext_wrap = std::make_shared<ExtractorWrap>(extractor, form_);
-        const DecodedInstructionInfo::PtrType& new_dii = std::make_shared<DecodedInstructionInfo>(mnemonic, uid_,
-                                                                                                  ext_wrap, meta_,
-                                                                                                  Opcode(0));
-        OpcodeInfo::PtrType optr = std::make_shared<OpcodeInfo>(Opcode(0), new_dii, ext_wrap, meta_, dasm_);
-        return std::make_shared<typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo>(optr, anno_);
+        const ExtractorWrap::PtrType& ext_wrap = makeShared<ExtractorWrap>(extractor, form_);
+        const DecodedInstructionInfo::PtrType& new_dii = makeShared<DecodedInstructionInfo>(mnemonic, uid_,
+                                                                                             ext_wrap, meta_,
+                                                                                             Opcode(0));
+        OpcodeInfo::PtrType optr = makeShared<OpcodeInfo>(Opcode(0), new_dii, ext_wrap, meta_, dasm_);
+        return makeShared<typename IFactoryIF<InstType, AnnotationType>::IFactoryInfo>(optr, anno_);
+    }
+
+    /**
+     * \brief Resolve everything needed to build this pseudo instruction directly (see
+     * DirectInstHandle)
+     */
+    DirectInstHandle<AnnotationType> prepareDirect(const std::string& mnemonic) const
+    {
+        return DirectInstHandle<AnnotationType>(mnemonic, uid_, meta_, dasm_, anno_, form_);
     }
 
     void setDisassembler(const DisassemblerIF::PtrType& dasm)
@@ -115,6 +124,17 @@ private:
         return nullptr;
     }
 
+    typename IFactoryIF<InstType, AnnotationType>::TypeBits getTypes(Opcode) override
+    {
+        throw std::runtime_error("Unimplemented");
+    }
+
+    typename IFactoryIF<InstType, AnnotationType>::TypeBits
+    getTypes(const std::string&, Opcode, const ExtractorIF::PtrType&) override
+    {
+        throw std::runtime_error("Unimplemented");
+    }
+
     void flushCaches() override
     {}
 };
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace mavis {
+
+/**
+ * \brief Vector-like container holding up to N elements in place
+ *
+ * Operand and register lists almost always hold a handful of entries, so keeping them inline
+ * avoids a heap allocation for every list built during decode. Lists that outgrow N (e.g. the
+ * implied registers of Zcmp push/pop) spill to the heap.
+ *
+ * Only trivially copyable element types are supported.
+ */
+template<typename T, uint32_t N>
+class InlineVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "InlineVector requires a trivially copyable type");
+    static_assert(N > 0, "InlineVector requires a non-zero inline capacity");
+
+public:
+    typedef T               value_type;
+    typedef uint32_t        size_type;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef T*              iterator;
+    typedef const T*        const_iterator;
+
+    InlineVector() = default;
+
+    InlineVector(std::initializer_list<T> init)
+    {
+        assign_(init.begin(), init.end());
+    }
+
+    template<typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+    InlineVector(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    // Keep code which builds the lists as std::vectors working
+    InlineVector(const std::vector<T>& vec)
+    {
+        assign_(vec.data(), vec.data() + vec.size());
+    }
+
+    InlineVector(const InlineVector& other)
+    {
+        assign_(other.begin(), other.end());
+    }
+
+    InlineVector(InlineVector&& other) noexcept :
+        size_(other.size_),
+        capacity_(other.capacity_),
+        heap_(std::move(other.heap_))
+    {
+        if (heap_ == nullptr) {
+            std::copy(other.inline_.begin(), other.inline_.begin() + size_, inline_.begin());
+        }
+        other.size_ = 0;
+        other.capacity_ = N;
+    }
+
+    InlineVector& operator=(const InlineVector& other)
+    {
+        if (this != &other) {
+            clear();
+            assign_(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    InlineVector& operator=(InlineVector&& other) noexcept
+    {
+        if (this != &other) {
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            heap_ = std::move(other.heap_);
+            if (heap_ == nullptr) {
+                std::copy(other.inline_.begin(), other.inline_.begin() + size_, inline_.begin());
+            }
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+        return *this;
+    }
+
+    T* data() { return (heap_ == nullptr) ? inline_.data() : heap_.get(); }
+    const T* data() const { return (heap_ == nullptr) ? inline_.data() : heap_.get(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    // Whether the elements are held in place (i.e. no heap allocation)
+    bool isInline() const { return heap_ == nullptr; }
+
+    T& operator[](size_type idx) { return data()[idx]; }
+    const T& operator[](size_type idx) const { return data()[idx]; }
+
+    const T& at(size_type idx) const
+    {
+        if (idx >= size_) [[unlikely]] {
+            throw std::out_of_range("InlineVector::at");
+        }
+        return data()[idx];
+    }
+
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+    T& back() { return data()[size_ - 1]; }
+    const T& back() const { return data()[size_ - 1]; }
+
+    void reserve(size_type cap)
+    {
+        if (cap > capacity_) {
+            std::unique_ptr<T[]> new_heap(new T[cap]);
+            std::copy(begin(), end(), new_heap.get());
+            heap_ = std::move(new_heap);
+            capacity_ = cap;
+        }
+    }
+
+    void push_back(const T& val)
+    {
+        if (size_ == capacity_) [[unlikely]] {
+            const T copy = val; // val may live in the storage about to be replaced
+            reserve(2 * capacity_);
+            data()[size_++] = copy;
+            return;
+        }
+        data()[size_++] = val;
+    }
+
+    template<class ...ArgTypes>
+    T& emplace_back(ArgTypes&& ... args)
+    {
+        push_back(T(std::forward<ArgTypes>(args)...));
+        return back();
+    }
+
+    void pop_back() { --size_; }
+
+    void clear() { size_ = 0; }
+
+    bool operator==(const InlineVector& other) const
+    {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+    bool operator!=(const InlineVector& other) const { return !(*this == other); }
+
+private:
+    template<typename PtrType>
+    void assign_(PtrType first, PtrType last)
+    {
+        reserve(static_cast<size_type>(last - first));
+        std::copy(first, last, data());
+        size_ = static_cast<size_type>(last - first);
+    }
+
+    uint32_t                size_ = 0;
+    uint32_t                capacity_ = N;
+    std::array<T, N>        inline_;
+    std::unique_ptr<T[]>    heap_;
+};
+
+} // namespace mavis
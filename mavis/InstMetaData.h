@@ -9,14 +9,16 @@
 #include <boost/json.hpp>
 
 #include "DecoderExceptions.h"
+#include "DenseEnumMap.hpp"
 #include "Form.h"
 #include "Tag.hpp"
 #include "MatchSet.hpp"
+#include "RefPtr.hpp"
 
 namespace mavis
 {
 
-    class InstMetaData
+    class InstMetaData : public RefCounted
     {
       private:
         using json = boost::json::object;
@@ -188,7 +190,7 @@ namespace mavis
             __N = NONE
         };
 
-        typedef std::shared_ptr<InstMetaData> PtrType;
+        typedef SharedPtr<InstMetaData> PtrType;
 
         // Make SpecialField a bitmap
         enum class SpecialField : uint32_t
@@ -208,8 +210,11 @@ namespace mavis
             STACK_ADJ, // Stack adjustment for zcmp instructions
             N_SPECIAL_FIELDS
         };
-        // Map of special field to value
-        using SpecialFieldsMap = std::map<SpecialField, uint32_t>;
+        // Map of special field to value. SpecialField is small and dense, so this is a fixed
+        // array with a presence mask rather than a tree
+        using SpecialFieldsMap =
+            DenseEnumMap<SpecialField, uint32_t,
+                         static_cast<uint32_t>(SpecialField::N_SPECIAL_FIELDS)>;
 
         static const inline std::map<InstMetaData::SpecialField, const std::string> sf_to_string_map{
             {InstMetaData::SpecialField::AQ       , "aq"        },
@@ -263,7 +268,7 @@ namespace mavis
          */
         InstMetaData(const InstMetaData & other) = default;
 
-        InstMetaData::PtrType clone() const { return std::make_shared<InstMetaData>(*this); }
+        InstMetaData::PtrType clone() const { return makeShared<InstMetaData>(*this); }
 
         /**
          * Construct according to ISA (for custom instruction factories)
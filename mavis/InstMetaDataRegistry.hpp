@@ -17,7 +17,7 @@ public:
     template<typename ...ArgTypes>
     InstMetaData::PtrType makeInstMetaData(const std::string& mnemonic, ArgTypes&& ...args)
     {
-        const InstMetaData::PtrType& meta = std::make_shared<InstMetaData>(std::forward<ArgTypes>(args)...);
+        const InstMetaData::PtrType& meta = makeShared<InstMetaData>(std::forward<ArgTypes>(args)...);
         if (registry_.find(mnemonic) == registry_.end()) {
             registry_[mnemonic] = meta;
         } else {
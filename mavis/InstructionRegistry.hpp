@@ -3,7 +3,7 @@
 #include "DecoderTypes.h"
 #include "DecoderExceptions.h"
 #include "SimpleDynArray.hpp"
-#include <map>
+#include <unordered_map>
 
 namespace mavis {
 
@@ -74,11 +74,11 @@ public:
 
     InstructionUniqueID lookupUID(const std::string& mnemonic) const
     {
-        try {
-            return id_map_.at(mnemonic);
-        } catch (const std::out_of_range& exc) {
+        const auto iter = id_map_.find(mnemonic);
+        if (iter == id_map_.end()) {
             return INVALID_UID;
         }
+        return iter->second;
     }
 
     const std::string& lookupMnemonic(const InstructionUniqueID uid) const
@@ -86,6 +86,18 @@ public:
         return mnemonic_array_[uid];
     }
 
+    // Call callback(mnemonic, uid) for every registered instruction, skipping mnemonics that
+    // only alias another instruction's UID (compressed instructions)
+    template<typename CallbackType>
+    void forEachInst(CallbackType&& callback) const
+    {
+        for (const auto& [mnemonic, uid] : id_map_) {
+            if (mnemonic_array_.contains(uid) && (mnemonic_array_[uid] == mnemonic)) {
+                callback(mnemonic, uid);
+            }
+        }
+    }
+
     // This method is used by the builder to set up an "alias" from a compressed
     // instruction to its expanded form. Both the compressed and the expansion
     // share the same UID. We don't want to add this to the mnemonic_array_ since it
@@ -150,9 +162,11 @@ public:
     }
 
 private:
-    UIDManager                                       uid_man_;
-    std::map<const std::string, InstructionUniqueID> id_map_;
-    SimpleDynArray<std::string>                      mnemonic_array_;
+    // Mnemonic -> UID goes through a hash table; UID -> mnemonic is a dense array
+    // indexed by UID
+    UIDManager                                           uid_man_;
+    std::unordered_map<std::string, InstructionUniqueID> id_map_;
+    SimpleDynArray<std::string>                          mnemonic_array_;
 };
 
 } // namespace mavis
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "DecoderTypes.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief Compiled "first match wins" lookup over an ordered list of (mask, value) rules
+     *
+     * A rule matches an opcode when (icode & mask) == value. Rules are partitioned by mask, and
+     * each partition keeps its values in a sorted array. A lookup probes each distinct mask once
+     * (in order of the partition's earliest rule) and stops as soon as no remaining partition can
+     * hold an earlier rule than the one found. The cost therefore depends on the number of
+     * distinct masks, not on the number of rules.
+     */
+    class MaskMatchTable
+    {
+      public:
+        static constexpr uint32_t NO_MATCH = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * \brief Rebuild the table
+         * \param rules (mask, value) pairs in priority order (earlier rules win)
+         */
+        void build(const std::vector<std::pair<Opcode, Opcode>> & rules)
+        {
+            partitions_.clear();
+            for (uint32_t rule = 0; rule < rules.size(); ++rule)
+            {
+                const auto & [mask, value] = rules[rule];
+                if ((value & ~mask) != 0)
+                {
+                    continue; // Can never match
+                }
+                auto part = std::find_if(partitions_.begin(), partitions_.end(),
+                                         [mask](const Partition & p) { return p.mask == mask; });
+                if (part == partitions_.end())
+                {
+                    part = partitions_.insert(partitions_.end(), Partition{mask, rule, {}});
+                }
+                part->values.emplace_back(value, rule);
+            }
+
+            // Within a partition, equal values keep only the earliest rule
+            for (auto & part : partitions_)
+            {
+                std::stable_sort(part.values.begin(), part.values.end(),
+                                 [](const auto & a, const auto & b) { return a.first < b.first; });
+                part.values.erase(std::unique(part.values.begin(), part.values.end(),
+                                              [](const auto & a, const auto & b)
+                                              { return a.first == b.first; }),
+                                  part.values.end());
+            }
+        }
+
+        /**
+         * \brief Index of the first rule matching icode, or NO_MATCH
+         */
+        uint32_t find(const Opcode icode) const
+        {
+            uint32_t found = NO_MATCH;
+            for (const auto & part : partitions_)
+            {
+                if (part.first_rule >= found)
+                {
+                    break;
+                }
+                const Opcode key = icode & part.mask;
+                const auto itr = std::lower_bound(part.values.begin(), part.values.end(), key,
+                                                  [](const auto & entry, Opcode k)
+                                                  { return entry.first < k; });
+                if ((itr != part.values.end()) && (itr->first == key))
+                {
+                    found = std::min(found, itr->second);
+                }
+            }
+            return found;
+        }
+
+        // Number of distinct masks (the most probes a lookup makes)
+        size_t getNumPartitions() const { return partitions_.size(); }
+
+      private:
+        struct Partition
+        {
+            Opcode mask;
+            uint32_t first_rule; // Earliest rule with this mask
+            std::vector<std::pair<Opcode, uint32_t>> values; // (value, rule), sorted by value
+        };
+
+        // Ordered by first_rule (partitions are created in rule order)
+        std::vector<Partition> partitions_;
+    };
+
+} // namespace mavis
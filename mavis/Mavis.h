@@ -4,7 +4,11 @@
 #include "mavis/DecoderTypes.h"
 #include "mavis/DTable.h"
 #include "mavis/ContextRegistry.hpp"
+#include "mavis/DecodeView.hpp"
+#include "mavis/DependencyWindow.hpp"
+#include "mavis/DispatchTable.hpp"
 #include <memory>
+#include <span>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -40,8 +44,8 @@ class Mavis
     using FileNameListType = mavis::FileNameListType;
     using RegListType = mavis::ExtractorIF::RegListType;
     using OpInfoListType = mavis::OperandInfo::ElementList;
-    using DecodeInfoType =
-        typename mavis::IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType;
+    using DecodeInfo = typename mavis::IFactoryIF<InstType, AnnotationType>::IFactoryInfo;
+    using DecodeInfoType = typename DecodeInfo::PtrType;
     using InstructionType = mavis::InstMetaData::InstructionTypes;
     using ExtractedInstType = mavis::OpcodeInfo::ExtractedInstTypes;
     using DirectInfoType = mavis::ExtractorDirectInfo;
@@ -49,7 +53,10 @@ class Mavis
     using ContextRegistryType =
         mavis::ContextRegistry<InstType, AnnotationType, AnnotationTypeAllocator>;
     using InstUIDList = mavis::InstUIDList;
+    using DirectHandle = mavis::DirectInstHandle<AnnotationType>;
     using AnnotationOverrides = mavis::AnnotationOverrides;
+    using DecodeViewType = mavis::DecodeView<InstType, AnnotationType, InstTypeAllocator,
+                                             AnnotationTypeAllocator>;
 
   public:
     /**
@@ -150,12 +157,47 @@ class Mavis
 
     bool hasContext(const std::string & name) { return context_.hasContext(name); }
 
+    /**
+     * \brief A per-hart decode view bound to one of this facade's contexts (see
+     * mavis::DecodeView). Views switch contexts independently of the facade and of each other
+     */
+    DecodeViewType makeDecodeView(const std::string & context_name) const
+    {
+        return DecodeViewType(context_, context_name, inst_allocator_);
+    }
+
+    const ContextRegistryType & getContextRegistry() const { return context_; }
+
     template <typename... ArgTypes>
     typename InstType::PtrType makeInst(const mavis::Opcode icode, ArgTypes &&... args)
     {
         return dtrie_->makeInst(icode, inst_allocator_, std::forward<ArgTypes>(args)...);
     }
 
+    /**
+     * \brief Decode into caller-owned instruction storage (e.g. a preallocated decode queue slot)
+     * by morphing it, rather than allocating a new instruction
+     * \param icode Opcode to decode
+     * \param inst Instruction to reinitialize (through InstType::morph())
+     */
+    void decodeInto(const mavis::Opcode icode, InstType & inst) { dtrie_->decodeInto(icode, inst); }
+
+    /**
+     * \brief Batch form of decodeInto(): decodes icodes[i] into insts[i]. If an opcode fails to
+     * decode, the exception propagates with the preceding slots already filled in
+     */
+    void decodeInto(std::span<const mavis::Opcode> icodes, std::span<InstType> insts)
+    {
+        if (insts.size() < icodes.size()) [[unlikely]]
+        {
+            throw std::invalid_argument("decodeInto: fewer instruction slots than opcodes");
+        }
+        for (size_t i = 0; i < icodes.size(); ++i)
+        {
+            dtrie_->decodeInto(icodes[i], insts[i]);
+        }
+    }
+
     template <typename TraceInfoType, typename... ArgTypes>
     typename InstType::PtrType makeInstFromTrace(const TraceInfoType & tinfo, ArgTypes &&... args)
     {
@@ -170,6 +212,71 @@ class Mavis
                                         std::forward<ArgTypes>(args)...);
     }
 
+    /**
+     * \brief Resolve a handle for building the given instruction directly. Building from the
+     * handle skips all of the registry lookups that makeInstDirectly(ex_info) does on every call
+     * \param uid Instruction UID
+     * \return Handle to pass to makeInstDirectly() or morphInst()
+     */
+    DirectHandle prepareDirect(const mavis::InstructionUniqueID uid) const
+    {
+        return dtrie_->prepareDirect(uid);
+    }
+
+    DirectHandle prepareDirect(const std::string & mnemonic) const
+    {
+        return dtrie_->prepareDirect(mnemonic);
+    }
+
+    /**
+     * \brief Build an instruction from a prepared handle
+     * \param handle Handle from prepareDirect()
+     * \param operands Operand values (its mnemonic/UID are ignored)
+     * \param args InstType construction args
+     * \throws UnknownMnemonic if the handle is not valid (default constructed)
+     * \return Pointer to constructed InstType
+     */
+    template <typename... ArgTypes>
+    typename InstType::PtrType makeInstDirectly(const DirectHandle & handle,
+                                                const mavis::ExtractorDirectInfoIF & operands,
+                                                ArgTypes &&... args)
+    {
+        return dtrie_->makeInstDirectly(handle, operands, inst_allocator_,
+                                        std::forward<ArgTypes>(args)...);
+    }
+
+    /**
+     * \brief Resolve a handle for building the given pseudo instruction directly
+     * \param uid Pseudo instruction UID
+     * \return Handle to pass to makePseudoInst()
+     */
+    DirectHandle preparePseudoInst(const mavis::InstructionUniqueID uid) const
+    {
+        const std::string & mnemonic = lookupPseudoInstMnemonic(uid);
+        const typename mavis::IFactoryPseudo<InstType, AnnotationType>::PtrType & ifact =
+            pseudo_builder_->findIFact(uid);
+        if (ifact == nullptr)
+        {
+            throw mavis::UnknownPseudoMnemonic(mnemonic);
+        }
+        return ifact->prepareDirect(mnemonic);
+    }
+
+    /**
+     * \brief Build a pseudo instruction from a prepared handle
+     * \param handle Handle from preparePseudoInst()
+     * \param operands Operand values (its mnemonic/UID are ignored)
+     * \param args InstType construction args
+     * \return Pointer to constructed InstType
+     */
+    template <typename... ArgTypes>
+    typename InstType::PtrType makePseudoInst(const DirectHandle & handle,
+                                              const mavis::ExtractorDirectInfoIF & operands,
+                                              ArgTypes &&... args)
+    {
+        return makeInstDirectly(handle, operands, std::forward<ArgTypes>(args)...);
+    }
+
     /**
      * @brief makePseudoInst -- create a pseudo instruction (InstType)
      * @tparam ArgTypes
@@ -182,36 +289,23 @@ class Mavis
     typename InstType::PtrType makePseudoInst(const mavis::ExtractorDirectInfoIF & ex_info,
                                               ArgTypes &&... args)
     {
-        typename InstType::PtrType inst = nullptr;
-        // typename mavis::IFactoryIF<InstType, AnnotationType>::PtrType ifact = nullptr;
-        typename mavis::IFactoryPseudo<InstType, AnnotationType>::PtrType ifact = nullptr;
-        std::string mnemonic = ex_info.getMnemonic();
         const mavis::InstructionUniqueID uid = ex_info.getUID();
 
-        // Try to look up the factory by UID (if present)
+        // Try to look up the factory by UID (if present). Both the factory and the mnemonic are
+        // held in UID-indexed tables
         if (uid != mavis::INVALID_UID)
         {
-            mnemonic = lookupPseudoInstMnemonic(uid);
-            ifact = pseudo_builder_->findIFact(uid);
+            return makePseudoInst_(pseudo_builder_->findIFact(uid),
+                                   lookupPseudoInstMnemonic(uid), ex_info,
+                                   std::forward<ArgTypes>(args)...);
         }
         else
         {
             // Look up the factory for the given mnemonic
-            ifact = pseudo_builder_->findIFact(mnemonic);
+            const std::string mnemonic = ex_info.getMnemonic();
+            return makePseudoInst_(pseudo_builder_->findIFact(mnemonic), mnemonic, ex_info,
+                                   std::forward<ArgTypes>(args)...);
         }
-
-        if (ifact == nullptr)
-        {
-            throw mavis::UnknownPseudoMnemonic(mnemonic);
-        }
-        else
-        {
-            const typename mavis::IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType &
-                info = ifact->getInfo(mnemonic, ex_info.clone());
-            inst = inst_allocator_(info->opinfo, info->uinfo, std::forward<ArgTypes>(args)...);
-        }
-
-        return inst;
     }
 
     void morphInst(typename InstType::PtrType inst,
@@ -220,21 +314,62 @@ class Mavis
         dtrie_->morphInst(inst, user_info);
     }
 
+    void morphInst(typename InstType::PtrType inst, const DirectHandle & handle,
+                   const mavis::ExtractorDirectInfoIF & operands) const
+    {
+        dtrie_->morphInst(inst, handle, operands);
+    }
+
     // Not const because getInfo will cache instruction information
     DecodeInfoType getInfo(const mavis::Opcode icode) { return dtrie_->getInfo(icode); }
 
-    // Not const because getInfo will cache instruction information
+    /**
+     * \brief Borrowing version of getInfo(): no shared pointer is copied (so no reference count
+     * traffic). The reference is valid until the next flushCaches() or switchContext()
+     */
+    const DecodeInfo & getInfoRef(const mavis::Opcode icode) { return dtrie_->getInfoRef(icode); }
+
+    /**
+     * \brief Decode to a compact, trivially copyable record (UID, registers, immediate, type
+     * bits, size, flags) instead of an OpcodeInfo. The result holds no references into Mavis, so
+     * it can be copied anywhere and outlives flushes and context switches
+     */
+    mavis::CompactInst decodeCompact(const mavis::Opcode icode)
+    {
+        return dtrie_->decodeCompact(icode);
+    }
+
+    /**
+     * \brief Vector register groups and element parameters of icode under vtype (the value
+     * vsetvl* writes to the vtype CSR), cached per (opcode, vtype). Like decodeCompact(), the
+     * result is a copy that holds no references into Mavis. vl does not change the groups;
+     * narrow them with VectorInst::getBodyMask()
+     */
+    mavis::VectorInst decodeVector(const mavis::Opcode icode, const uint64_t vtype)
+    {
+        return dtrie_->decodeVector(icode, vtype);
+    }
+
+    // Not const because the classification is cached
     bool isOpcodeInstType(Opcode icode, InstructionType itype)
     {
-        const DecodeInfoType info = getInfo(icode);
-        return info->opinfo->isInstType(itype);
+        const auto bits = static_cast<std::underlying_type_t<InstructionType>>(itype);
+        return (dtrie_->classify(icode).inst_types & bits) == bits;
     }
 
-    // Not const because getInfo will cache instruction information
+    // Not const because the classification is cached
     bool isOpcodeExtractedInstType(Opcode icode, ExtractedInstType itype)
     {
-        const DecodeInfoType info = getInfo(icode);
-        return info->opinfo->isExtractedInstType(itype);
+        const auto bits = static_cast<std::underlying_type_t<ExtractedInstType>>(itype);
+        return (dtrie_->classify(icode).ext_inst_types & bits) == bits;
+    }
+
+    /**
+     * \brief All of the InstructionTypes bits of an opcode, for testing several types at once
+     */
+    std::underlying_type_t<InstructionType> getOpcodeInstTypes(Opcode icode)
+    {
+        return dtrie_->classify(icode).inst_types;
     }
 
     mavis::InstructionUniqueID lookupInstructionUniqueID(const std::string & mnemonic) const
@@ -252,6 +387,18 @@ class Mavis
         return builder_->findInstructionMnemonic(uid);
     }
 
+    /**
+     * \brief Call callback(mnemonic, uid, meta, base_mnemonic) for every instruction of the
+     * current context that owns its UID (compressed instructions share their expansion's UID and
+     * are skipped). meta is an InstMetaData::PtrType; for overlays (e.g. nop) it is the
+     * overlay's metadata and base_mnemonic the instruction it overlays (addi), otherwise
+     * base_mnemonic is the mnemonic itself
+     */
+    template <typename CallbackType> void forEachInstruction(CallbackType && callback) const
+    {
+        builder_->forEachInstruction(std::forward<CallbackType>(callback));
+    }
+
     const std::string & lookupPseudoInstMnemonic(const mavis::InstructionUniqueID uid) const
     {
         return pseudo_builder_->findInstructionMnemonic(uid);
@@ -278,6 +425,60 @@ class Mavis
 
     void flushCaches() { dtrie_->flushCaches(); }
 
+    /**
+     * \brief Optimize the decode trie of the current context once it is complete (see
+     * DTable::optimize()). Decode results are unchanged
+     * \return The trie's shape before and after
+     */
+    std::pair<mavis::TrieStats, mavis::TrieStats> optimizeDecodeTrie()
+    {
+        return dtrie_->optimize();
+    }
+
+    /**
+     * \brief Pre-warm the decode caches of the current context with the hottest opcodes of a
+     * recorded instruction mix (see mavis::DecodeProfile and DTable::prewarm()). Call it after
+     * configuration (and after optimizeDecodeTrie(), if used); flushCaches() undoes it
+     * \return The number of opcodes loaded into the caches
+     */
+    size_t applyDecodeProfile(const mavis::DecodeProfile & profile)
+    {
+        return dtrie_->prewarm(profile);
+    }
+
+    /**
+     * \brief Generate a standalone C++ decoder header for the current context (see
+     * mavis::StaticDecoderWriter). Check the result against this configuration with
+     * mavis::checkStaticDecoder() and mavis::checkStaticDecoderOperands()
+     * \param os Where to write the header
+     * \param class_name Name of the generated struct
+     * \param description Recorded in the header (e.g. the ISA string it was generated for)
+     */
+    void writeStaticDecoder(std::ostream & os, const std::string & class_name,
+                            const std::string & description = "") const
+    {
+        dtrie_->writeStaticDecoder(os, class_name, description);
+    }
+
+    /**
+     * \brief Flatten the decode trie of the current context into a read-only, pointer-free
+     * mavis::DecodeImage that can be shared between processes
+     * \param description Recorded in the image (e.g. the ISA string it was built for)
+     */
+    mavis::DecodeImage buildDecodeImage(const std::string & description = "") const
+    {
+        return mavis::DecodeImage::fromWords(dtrie_->buildDecodeImage(description));
+    }
+
+    /**
+     * \brief Write the decode image of the current context to a file for
+     * mavis::DecodeImage::map()
+     */
+    void writeDecodeImage(std::ostream & os, const std::string & description = "") const
+    {
+        dtrie_->writeDecodeImage(os, description);
+    }
+
     uint64_t getUID() const { return uid_; }
 
   private:
@@ -297,6 +498,22 @@ class Mavis
   private:
     void print(std::ostream & os) const { os << *dtrie_; }
 
+    template <typename... ArgTypes>
+    typename InstType::PtrType makePseudoInst_(
+        const typename mavis::IFactoryPseudo<InstType, AnnotationType>::PtrType & ifact,
+        const std::string & mnemonic, const mavis::ExtractorDirectInfoIF & ex_info,
+        ArgTypes &&... args)
+    {
+        if (ifact == nullptr)
+        {
+            throw mavis::UnknownPseudoMnemonic(mnemonic);
+        }
+
+        const typename mavis::IFactoryIF<InstType, AnnotationType>::IFactoryInfo::PtrType & info =
+            ifact->getInfo(mnemonic, ex_info.clone());
+        return inst_allocator_(info->opinfo, info->uinfo, std::forward<ArgTypes>(args)...);
+    }
+
   public:
     friend std::ostream & operator<<(std::ostream & os, const Mavis & facade)
     {
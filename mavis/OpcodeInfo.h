@@ -13,10 +13,10 @@ namespace mavis
     // It will cause a small hit to performance
     // Need to decide whether this is worth it
     // TODO: Add proxy interfaces for the operand type stuff
-    class OpcodeInfo
+    class OpcodeInfo : public RefCounted
     {
       public:
-        typedef std::shared_ptr<OpcodeInfo> PtrType;
+        typedef SharedPtr<OpcodeInfo> PtrType;
 
         using InstructionTypes = InstMetaData::InstructionTypes;
         using ISAExtension = InstMetaData::ISAExtension;
@@ -48,166 +48,108 @@ namespace mavis
             return dasm_->toString(getMnemonic(), icode_, meta_, extractor_);
         }
 
-        bool isHint() const { return info_->is_hint; }
+        bool isHint() const { return info_->isHint(); }
 
-        ImmediateType getImmediateType() const { return info_->immediate_type; }
+        ImmediateType getImmediateType() const { return info_->getImmediateType(); }
 
-        bool hasImmediate() const { return info_->has_immediate; }
+        bool hasImmediate() const { return info_->hasImmediate(); }
 
-        uint64_t getImmediate() const { return info_->immediate; }
+        uint64_t getImmediate() const { return info_->getImmediate(); }
 
-        uint64_t getUnsignedOffset() const { return info_->immediate; }
+        uint64_t getUnsignedOffset() const { return info_->getImmediate(); }
 
-        int64_t getSignedOffset() const { return info_->signed_offset; }
+        int64_t getSignedOffset() const { return info_->getSignedOffset(); }
 
-        DecodedInstructionInfo::BitMask getSourceRegs() const { return info_->sources; }
+        DecodedInstructionInfo::BitMask getSourceRegs() const { return info_->getSourceRegs(); }
 
-        const OperandInfo & getSourceOpInfo() const { return info_->source_opinfo; }
+        const OperandInfo & getSourceOpInfo() const { return info_->getSourceOpInfo(); }
 
         const OperandInfo::ElementList & getSourceOpInfoList() const
         {
-            return info_->source_opinfo_list;
+            return info_->getSourceOpInfoList();
         }
 
-        DecodedInstructionInfo::BitMask getIntSourceRegs() const { return info_->int_sources; }
+        DecodedInstructionInfo::BitMask getIntSourceRegs() const
+        {
+            return info_->getIntSourceRegs();
+        }
 
-        DecodedInstructionInfo::BitMask getFloatSourceRegs() const { return info_->float_sources; }
+        DecodedInstructionInfo::BitMask getFloatSourceRegs() const
+        {
+            return info_->getFloatSourceRegs();
+        }
 
         DecodedInstructionInfo::BitMask getVectorSourceRegs() const
         {
-            return info_->vector_sources;
+            return info_->getVectorSourceRegs();
         }
 
         DecodedInstructionInfo::BitMask getSourceRegsByType(OperandTypes otype) const
         {
-            switch (otype)
-            {
-                case OperandTypes::WORD:
-                    return info_->word_sources;
-                case OperandTypes::LONG:
-                    return info_->long_sources;
-                case OperandTypes::HALF:
-                    return info_->half_sources;
-                case OperandTypes::SINGLE:
-                    return info_->single_sources;
-                case OperandTypes::DOUBLE:
-                    return info_->double_sources;
-                case OperandTypes::QUAD:
-                    return info_->quad_sources;
-                case OperandTypes::VECTOR:
-                    return info_->vector_sources;
-                case OperandTypes::__N:
-                    throw std::invalid_argument("invalid operand type");
-            }
-            return DecodedInstructionInfo::BitMask();
+            return info_->getSourceRegsByType(otype);
         }
 
-        uint32_t numSourceRegs() const { return info_->n_sources; }
+        uint32_t numSourceRegs() const { return info_->numSourceRegs(); }
 
-        uint32_t numIntSourceRegs() const { return info_->int_n_sources; }
+        uint32_t numIntSourceRegs() const { return info_->numIntSourceRegs(); }
 
-        uint32_t numFloatSourceRegs() const { return info_->float_n_sources; }
+        uint32_t numFloatSourceRegs() const { return info_->numFloatSourceRegs(); }
 
-        uint32_t numVectorSourceRegs() const { return info_->vector_n_sources; }
+        uint32_t numVectorSourceRegs() const { return info_->numVectorSourceRegs(); }
 
         uint32_t numSourceRegsByType(OperandTypes otype) const
         {
-            switch (otype)
-            {
-                case OperandTypes::WORD:
-                    return info_->word_n_sources;
-                case OperandTypes::LONG:
-                    return info_->long_n_sources;
-                case OperandTypes::HALF:
-                    return info_->half_n_sources;
-                case OperandTypes::SINGLE:
-                    return info_->single_n_sources;
-                case OperandTypes::DOUBLE:
-                    return info_->double_n_sources;
-                case OperandTypes::QUAD:
-                    return info_->quad_n_sources;
-                case OperandTypes::VECTOR:
-                    return info_->vector_n_sources;
-                case OperandTypes::__N:
-                    throw std::invalid_argument("invalid operand type");
-            }
-            return std::numeric_limits<uint32_t>::max();
+            return info_->numSourceRegsByType(otype);
         }
 
-        DecodedInstructionInfo::BitMask getDestRegs() const { return info_->dests; }
+        DecodedInstructionInfo::BitMask getDestRegs() const { return info_->getDestRegs(); }
 
-        const OperandInfo & getDestOpInfo() const { return info_->dest_opinfo; }
+        const OperandInfo & getDestOpInfo() const { return info_->getDestOpInfo(); }
 
         const OperandInfo::ElementList & getDestOpInfoList() const
         {
-            return info_->dest_opinfo_list;
+            return info_->getDestOpInfoList();
         }
 
-        DecodedInstructionInfo::BitMask getIntDestRegs() const { return info_->int_dests; }
+        DecodedInstructionInfo::BitMask getIntDestRegs() const { return info_->getIntDestRegs(); }
 
-        DecodedInstructionInfo::BitMask getFloatDestRegs() const { return info_->float_dests; }
+        DecodedInstructionInfo::BitMask getFloatDestRegs() const
+        {
+            return info_->getFloatDestRegs();
+        }
 
-        DecodedInstructionInfo::BitMask getVectorDestRegs() const { return info_->vector_dests; }
+        DecodedInstructionInfo::BitMask getVectorDestRegs() const
+        {
+            return info_->getVectorDestRegs();
+        }
 
         DecodedInstructionInfo::BitMask getDestRegsByType(OperandTypes otype) const
         {
-            switch (otype)
-            {
-                case OperandTypes::WORD:
-                    return info_->word_dests;
-                case OperandTypes::LONG:
-                    return info_->long_dests;
-                case OperandTypes::HALF:
-                    return info_->half_dests;
-                case OperandTypes::SINGLE:
-                    return info_->single_dests;
-                case OperandTypes::DOUBLE:
-                    return info_->double_dests;
-                case OperandTypes::QUAD:
-                    return info_->quad_dests;
-                case OperandTypes::VECTOR:
-                    return info_->vector_dests;
-                case OperandTypes::__N:
-                    throw std::invalid_argument("invalid operand type");
-            }
-            return DecodedInstructionInfo::BitMask();
+            return info_->getDestRegsByType(otype);
         }
 
-        uint32_t numDestRegs() const { return info_->n_dests; }
+        uint32_t numDestRegs() const { return info_->numDestRegs(); }
 
-        uint32_t numIntDestRegs() const { return info_->int_n_dests; }
+        uint32_t numIntDestRegs() const { return info_->numIntDestRegs(); }
 
-        uint32_t numFloatDestRegs() const { return info_->float_n_dests; }
+        uint32_t numFloatDestRegs() const { return info_->numFloatDestRegs(); }
 
-        uint32_t numVectorDestRegs() const { return info_->vector_n_dests; }
+        uint32_t numVectorDestRegs() const { return info_->numVectorDestRegs(); }
 
         uint32_t numDestRegsByType(OperandTypes otype) const
         {
-            switch (otype)
-            {
-                case OperandTypes::WORD:
-                    return info_->word_n_dests;
-                case OperandTypes::LONG:
-                    return info_->long_n_dests;
-                case OperandTypes::HALF:
-                    return info_->half_n_dests;
-                case OperandTypes::SINGLE:
-                    return info_->single_n_dests;
-                case OperandTypes::DOUBLE:
-                    return info_->double_n_dests;
-                case OperandTypes::QUAD:
-                    return info_->quad_n_dests;
-                case OperandTypes::VECTOR:
-                    return info_->vector_n_dests;
-                case OperandTypes::__N:
-                    throw std::invalid_argument("invalid operand type");
-            }
-            return std::numeric_limits<uint32_t>::max();
+            return info_->numDestRegsByType(otype);
         }
 
-        DecodedInstructionInfo::BitMask getSourceAddressRegs() const { return info_->addr_sources; }
+        DecodedInstructionInfo::BitMask getSourceAddressRegs() const
+        {
+            return info_->getSourceAddressRegs();
+        }
 
-        DecodedInstructionInfo::BitMask getSourceDataRegs() const { return info_->data_sources; }
+        DecodedInstructionInfo::BitMask getSourceDataRegs() const
+        {
+            return info_->getSourceDataRegs();
+        }
 
         // TODO: Deprecate this completely... still used in Dabble::Instruction() for printing
         uint64_t getFunction() const
@@ -245,6 +187,11 @@ namespace mavis
             return info_->isExtInstType(itype);
         }
 
+        std::underlying_type_t<ExtractedInstTypes> getExtractedInstType() const
+        {
+            return info_->getExtInstType();
+        }
+
         std::underlying_type_t<ISAExtension> getISA() const { return meta_->getISA(); }
 
         bool isISA(ISAExtension isa) const { return meta_->isISA(isa); }
@@ -273,7 +220,7 @@ namespace mavis
         {
             try
             {
-                return info_->special_fields.at(sfid);
+                return info_->getSpecialFields().at(sfid);
             }
             catch (const std::out_of_range & ex)
             {
@@ -285,7 +232,7 @@ namespace mavis
 
         const SpecialFieldsMap& getSpecialFields() const
         {
-            return info_->special_fields;
+            return info_->getSpecialFields();
         }
 
       private:
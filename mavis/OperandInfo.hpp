@@ -3,8 +3,10 @@
 #include <vector>
 #include <array>
 #include <cinttypes>
+#include <limits>
 
 #include "InstMetaData.h"
+#include "InlineVector.hpp"
 
 namespace mavis {
 
@@ -34,32 +36,37 @@ public:
         Element() = default;
         Element(const Element&) = default;
         Element& operator=(const Element&) = default;
+
+        bool operator==(const Element& other) const {
+            return (field_id == other.field_id) && (operand_type == other.operand_type) &&
+                   (field_value == other.field_value) && (is_store_data == other.is_store_data) &&
+                   (is_implied == other.is_implied);
+        }
     };
 
-    typedef std::vector<Element> ElementList;
+    // Instructions have a handful of operands (Zcmp push/pop excepted), so the list is held in
+    // place and only spills to the heap for the rare large case
+    typedef InlineVector<Element, 4> ElementList;
 
 private:
+    using OperandTypesUnderLyingType = std::underlying_type_t<InstMetaData::OperandTypes>;
+    using OperandFieldIDUnderlyingType = std::underlying_type_t<InstMetaData::OperandFieldID>;
+
+    // Kept compact since every decoded instruction holds two of these: per field ID we only
+    // store the (1-based) index of the element carrying it, and the per-type counts are bytes
     ElementList     elems_;
-    uint32_t        n_opers_ = 0;
+    std::array<uint8_t, static_cast<OperandFieldIDUnderlyingType>(InstMetaData::OperandFieldID::__N)> field_idx_ = {0};
+    std::array<uint8_t, static_cast<OperandTypesUnderLyingType>(InstMetaData::OperandTypes::__N)>  n_types_ = {0};
     bool            has_implied_operand_ = false;
-    using OperandTypesUnderLyingType = std::underlying_type_t<InstMetaData::OperandTypes>;
-    std::array<uint32_t, static_cast<OperandTypesUnderLyingType>(InstMetaData::OperandTypes::__N)>  n_types_ = {0};
-
-    struct FieldIDInfo {
-        bool                       valid = false;
-        OpcodeFieldValueType       value = 0;
-        InstMetaData::OperandTypes type = InstMetaData::OperandTypes::NONE;
-        bool                       sdata = false;
-        bool                       implied = false;
-
-        bool operator==(const Element& elm) const {
-            return valid && (value == elm.field_value) && (type == elm.operand_type) && (sdata == elm.is_store_data) &&
-                   (implied == elm.is_implied);
-        }
-    };
 
-    using OperandFieldIDUnderlyingType = std::underlying_type_t<InstMetaData::OperandFieldID>;
-    std::array<FieldIDInfo, static_cast<OperandFieldIDUnderlyingType>(InstMetaData::OperandFieldID::__N)> field_id_list_;
+    static bool sameOperand_(const Element& a, const Element& b) {
+        return (a.field_value == b.field_value) && (a.operand_type == b.operand_type) &&
+               (a.is_store_data == b.is_store_data) && (a.is_implied == b.is_implied);
+    }
+
+    const Element& fieldElement_(InstMetaData::OperandFieldID fid) const {
+        return elems_[field_idx_[static_cast<OperandFieldIDUnderlyingType>(fid)] - 1];
+    }
 
 public:
     OperandInfo() = default;
@@ -78,7 +85,6 @@ public:
     void addElement(ElementArgs&& ... args)
     {
         const auto elem = elems_.emplace_back(std::forward<ElementArgs>(args)...);
-        ++n_opers_;
         has_implied_operand_ = has_implied_operand_ || elem.is_implied;
         bool duplicate_operand = false;
         if (elem.field_id != InstMetaData::OperandFieldID::NONE)
@@ -86,8 +92,7 @@ public:
             // allow multiple copies of the same exact operand...
             if (hasFieldID(elem.field_id))
             {
-                const FieldIDInfo& finfo = field_id_list_[static_cast<OperandFieldIDUnderlyingType>(elem.field_id)];
-                duplicate_operand = (finfo == elem);
+                duplicate_operand = sameOperand_(fieldElement_(elem.field_id), elem);
                 if (!duplicate_operand) [[unlikely]]
                 {
                     std::ostringstream ss;
@@ -101,8 +106,12 @@ public:
             }
             else
             {
-                field_id_list_[static_cast<OperandFieldIDUnderlyingType>(elem.field_id)] =
-                    {true, elem.field_value, elem.operand_type, elem.is_store_data, elem.is_implied};
+                if (elems_.size() > std::numeric_limits<uint8_t>::max()) [[unlikely]]
+                {
+                    throw std::runtime_error("Too many operands");
+                }
+                field_idx_[static_cast<OperandFieldIDUnderlyingType>(elem.field_id)] =
+                    static_cast<uint8_t>(elems_.size());
             }
         }
         if ((elem.operand_type != InstMetaData::OperandTypes::NONE) && (!duplicate_operand))
@@ -118,7 +127,7 @@ public:
 
     uint32_t getNOpers() const
     {
-        return n_opers_;
+        return elems_.size();
     }
 
     uint32_t getNTypes(InstMetaData::OperandTypes otype) const
@@ -140,13 +149,13 @@ public:
         if (fid == InstMetaData::OperandFieldID::NONE) {
             return false;
         }
-        return field_id_list_[static_cast<OperandFieldIDUnderlyingType>(fid)].valid;
+        return field_idx_[static_cast<OperandFieldIDUnderlyingType>(fid)] != 0;
     }
 
     OpcodeFieldValueType getFieldValue(InstMetaData::OperandFieldID fid) const
     {
         if (hasFieldID(fid)) {
-            return field_id_list_[static_cast<OperandFieldIDUnderlyingType>(fid)].value;
+            return fieldElement_(fid).field_value;
         } else {
             throw OperandInfoInvalidFieldID(InstMetaData::getFieldIDName(fid));
         }
@@ -155,7 +164,7 @@ public:
     InstMetaData::OperandTypes getFieldType(InstMetaData::OperandFieldID fid) const
     {
         if (hasFieldID(fid)) {
-            return field_id_list_[static_cast<OperandFieldIDUnderlyingType>(fid)].type;
+            return fieldElement_(fid).operand_type;
         } else {
             throw OperandInfoInvalidFieldID(InstMetaData::getFieldIDName(fid));
         }
@@ -164,7 +173,7 @@ public:
     bool isStoreData(InstMetaData::OperandFieldID fid) const
     {
         if (hasFieldID(fid)) {
-            return field_id_list_[static_cast<OperandFieldIDUnderlyingType>(fid)].sdata;
+            return fieldElement_(fid).is_store_data;
         } else {
             throw OperandInfoInvalidFieldID(InstMetaData::getFieldIDName(fid));
         }
@@ -173,7 +182,7 @@ public:
     bool isImplied(InstMetaData::OperandFieldID fid) const
     {
         if (hasFieldID(fid)) {
-            return field_id_list_[static_cast<OperandFieldIDUnderlyingType>(fid)].implied;
+            return fieldElement_(fid).is_implied;
         } else {
             throw OperandInfoInvalidFieldID(InstMetaData::getFieldIDName(fid));
         }
@@ -143,6 +143,16 @@ public:
         return ((icode & match_mask_) == match_value_);
     }
 
+    Opcode getMatchMask() const
+    {
+        return match_mask_;
+    }
+
+    Opcode getMatchValue() const
+    {
+        return match_value_;
+    }
+
     uint32_t getNumMaskBits() const
     {
         return n_match_mask_bits_;
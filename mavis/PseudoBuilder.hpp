@@ -25,7 +25,7 @@ private:
     //
     // Another way to do help the compiler find base class members is to explicitly de-reference
     // them with "this->". I've used that method for other members in the code below. I've opted to
-    // declare registry_ with "using" here instead, since registry_ is an std::map() and I'm doing
+    // declare registry_ with "using" here instead, since registry_ is a hash map and I'm doing
     // index operations on it. The syntax is cleaner for indexing registry_ this way.
     using FactoryBuilderBase<FactoryType, InstType, AnnotationType, AnnotationTypeAllocator>::registry_;
 
@@ -122,6 +122,7 @@ private:
 
             // Register it in our builder registry
             registry_[mnemonic] = ifact;
+            this->registerVariant(inst_uid, ifact, meta, panno);
         }
 
         return ifact;
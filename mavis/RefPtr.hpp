@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace mavis
+{
+
+    /**
+     * \brief Reference-counting policy for the decoder's internal handles
+     *
+     * OpcodeInfo, DecodedInstructionInfo, ExtractorIF, InstMetaData, and IFactoryInfo are held
+     * through mavis::SharedPtr. By default that is std::shared_ptr, whose reference counts are
+     * updated atomically. Defining MAVIS_SINGLE_THREADED (CMake option of the same name) switches
+     * it to RefPtr, an intrusive pointer with a plain (non-atomic) count kept in the object.
+     *
+     * The policy has to be the same in every translation unit that includes Mavis, so it is a
+     * build flag rather than a Mavis template parameter. Instruction and annotation pointers are
+     * not affected; they are chosen by the user via InstType::PtrType / AnnotationType::PtrType
+     * and the Mavis allocators.
+     */
+#ifdef MAVIS_SINGLE_THREADED
+
+    template <typename T> class RefPtr;
+
+    /**
+     * \brief Base class holding the reference count for RefPtr
+     *
+     * Copying an object does not copy its count: the copy starts unreferenced.
+     */
+    class RefCounted
+    {
+      protected:
+        RefCounted() = default;
+
+        RefCounted(const RefCounted &) {}
+
+        RefCounted & operator=(const RefCounted &) { return *this; }
+
+        ~RefCounted() = default;
+
+      private:
+        template <typename T> friend class RefPtr;
+
+        mutable uint32_t ref_count_ = 0;
+    };
+
+    /**
+     * \brief Intrusive, non-atomic reference-counted pointer to a RefCounted object
+     *
+     * Provides the subset of the std::shared_ptr interface used with the decoder's handles.
+     * Objects are deleted through RefPtr<T>, so T must have a virtual destructor if it is a
+     * polymorphic base.
+     */
+    template <typename T> class RefPtr
+    {
+      public:
+        using element_type = T;
+
+        RefPtr() = default;
+
+        RefPtr(std::nullptr_t) {}
+
+        explicit RefPtr(T* ptr) : ptr_(ptr) { acquire_(); }
+
+        RefPtr(const RefPtr & other) : ptr_(other.ptr_) { acquire_(); }
+
+        RefPtr(RefPtr && other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        RefPtr(const RefPtr<U> & other) : ptr_(other.get())
+        {
+            acquire_();
+        }
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        RefPtr(RefPtr<U> && other) : ptr_(other.get())
+        {
+            acquire_();
+            other.reset();
+        }
+
+        ~RefPtr() { release_(); }
+
+        RefPtr & operator=(const RefPtr & other)
+        {
+            RefPtr(other).swap(*this);
+            return *this;
+        }
+
+        RefPtr & operator=(RefPtr && other) noexcept
+        {
+            RefPtr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        RefPtr & operator=(std::nullptr_t)
+        {
+            reset();
+            return *this;
+        }
+
+        void reset() { RefPtr().swap(*this); }
+
+        void reset(T* ptr) { RefPtr(ptr).swap(*this); }
+
+        void swap(RefPtr & other) noexcept { std::swap(ptr_, other.ptr_); }
+
+        T* get() const { return ptr_; }
+
+        T & operator*() const { return *ptr_; }
+
+        T* operator->() const { return ptr_; }
+
+        explicit operator bool() const { return ptr_ != nullptr; }
+
+        long use_count() const { return (ptr_ == nullptr) ? 0 : ptr_->ref_count_; }
+
+      private:
+        void acquire_() const
+        {
+            if (ptr_ != nullptr)
+            {
+                ++ptr_->ref_count_;
+            }
+        }
+
+        void release_() const
+        {
+            if ((ptr_ != nullptr) && (--ptr_->ref_count_ == 0))
+            {
+                delete ptr_;
+            }
+        }
+
+        T* ptr_ = nullptr;
+    };
+
+    template <typename T, typename U>
+    inline bool operator==(const RefPtr<T> & lhs, const RefPtr<U> & rhs)
+    {
+        return lhs.get() == rhs.get();
+    }
+
+    template <typename T> inline bool operator==(const RefPtr<T> & lhs, std::nullptr_t)
+    {
+        return lhs.get() == nullptr;
+    }
+
+    template <typename T> using SharedPtr = RefPtr<T>;
+
+    template <typename T, typename... ArgTypes> inline SharedPtr<T> makeShared(ArgTypes &&... args)
+    {
+        return SharedPtr<T>(new T(std::forward<ArgTypes>(args)...));
+    }
+
+#else
+
+    // Nothing to hold: std::shared_ptr keeps its count in its own control block
+    class RefCounted
+    {
+    };
+
+    template <typename T> using SharedPtr = std::shared_ptr<T>;
+
+    template <typename T, typename... ArgTypes> inline SharedPtr<T> makeShared(ArgTypes &&... args)
+    {
+        return std::make_shared<T>(std::forward<ArgTypes>(args)...);
+    }
+
+#endif
+
+} // namespace mavis
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "Extractor.h"
+
+#include <algorithm>
+#include <bit>
+#include <cinttypes>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief The opcodes reaching a trie node: (icode & mask) == value, and (icode & select_mask)
+     * is one of select_values (when the path went through a match list). Used when lowering the
+     * trie into other forms (StaticDecoderWriter, DecodeImageWriter)
+     */
+    struct DecodePath
+    {
+        Opcode mask = 0;
+        Opcode value = 0;
+        Opcode select_mask = 0;
+        std::vector<Opcode> select_values; // Sorted
+
+        DecodePath restrict(const Opcode m, const Opcode v) const
+        {
+            DecodePath path = *this;
+            path.mask |= m;
+            path.value |= v & m;
+            return path;
+        }
+
+        // An opcode on the path
+        Opcode example() const
+        {
+            const Opcode sel = select_values.empty() ? 0 : select_values.front();
+            return (sel & ~mask) | value;
+        }
+
+        // Whether an opcode that satisfies mask/value also satisfies the select constraint
+        bool selects(const Opcode icode) const
+        {
+            return select_values.empty()
+                   || std::binary_search(select_values.begin(), select_values.end(),
+                                         icode & select_mask);
+        }
+
+        // A random 32-bit opcode on the path
+        Opcode sample(std::mt19937_64 & rng) const
+        {
+            Opcode icode = rng() & 0xffffffffull;
+            if (!select_values.empty())
+            {
+                icode = (icode & ~select_mask) | select_values[rng() % select_values.size()];
+            }
+            return (icode & ~mask) | value;
+        }
+    };
+
+    /**
+     * \brief All values of the opcode bits under mask, in ascending order
+     * \throws std::invalid_argument if mask has more than max_bits bits set
+     */
+    inline std::vector<Opcode> enumerateOpcodeBits(const Opcode mask, const uint32_t max_bits = 16)
+    {
+        if (static_cast<uint32_t>(std::popcount(mask)) > max_bits) [[unlikely]]
+        {
+            std::ostringstream ss;
+            ss << "mavis: too many opcode bits (0x" << std::hex << mask << ") to enumerate";
+            throw std::invalid_argument(ss.str());
+        }
+        std::vector<Opcode> values;
+        Opcode value = 0;
+        do
+        {
+            values.push_back(value);
+            value = (value - mask) & mask;
+        } while (value != 0);
+        return values;
+    }
+
+    /**
+     * \brief The reserved encodings (ExtractorIF::isIllop()) of an extractor among the opcodes
+     * reaching a path, as a test on a few opcode bits: the opcode is reserved iff
+     * ((icode & mask) is one of values) == list_bad
+     *
+     * Found by evaluating isIllop() on sampled opcodes to find the opcode bits it depends on,
+     * then enumerating those bits. That is exact for the extractors in this tree (they test a few
+     * small fields); generated decoders are guarded by a drift check for the rest.
+     */
+    struct ReservedEncodings
+    {
+        enum class Kind
+        {
+            NONE, // No reserved encodings on the path
+            ALL,  // Every opcode on the path is reserved
+            SOME
+        };
+
+        Kind kind = Kind::NONE;
+        Opcode mask = 0;
+        bool list_bad = true;
+        std::vector<Opcode> values; // Sorted
+
+        bool isReserved(const Opcode icode) const
+        {
+            switch (kind)
+            {
+                case Kind::NONE:
+                    return false;
+                case Kind::ALL:
+                    return true;
+                default:
+                    return std::binary_search(values.begin(), values.end(), icode & mask)
+                           == list_bad;
+            }
+        }
+
+        static ReservedEncodings find(const ExtractorIF::PtrType & extractor,
+                                      const DecodePath & path, std::mt19937_64 & rng)
+        {
+            std::vector<Opcode> illegal;
+            std::vector<Opcode> legal;
+            for (uint32_t i = 0; i < NUM_SAMPLES; ++i)
+            {
+                const Opcode icode = path.sample(rng);
+                auto & samples = extractor->isIllop(icode) ? illegal : legal;
+                if (samples.size() < NUM_DEPENDENCY_SAMPLES)
+                {
+                    samples.push_back(icode);
+                }
+            }
+            ReservedEncodings reserved;
+            if (illegal.empty())
+            {
+                return reserved;
+            }
+
+            // Opcode bits the check depends on: those whose flip (staying on the path) changes
+            // the outcome
+            const Opcode free_bits = 0xffffffffull & ~path.mask;
+            Opcode depends = 0;
+            for (const auto* samples : {&illegal, &legal})
+            {
+                for (const Opcode icode : *samples)
+                {
+                    const bool is_illegal = extractor->isIllop(icode);
+                    for (Opcode bits = free_bits & ~depends; bits != 0; bits &= bits - 1)
+                    {
+                        const Opcode flipped = icode ^ (bits & -bits);
+                        if (path.selects(flipped) && (extractor->isIllop(flipped) != is_illegal))
+                        {
+                            depends |= bits & -bits;
+                        }
+                    }
+                }
+            }
+
+            // Classify every combination of those bits that is on the path
+            std::vector<Opcode> bad;
+            std::vector<Opcode> good;
+            const Opcode base = illegal.front() & ~depends;
+            for (const Opcode value : enumerateOpcodeBits(depends))
+            {
+                if (path.selects(base | value))
+                {
+                    (extractor->isIllop(base | value) ? bad : good).push_back(value);
+                }
+            }
+
+            if (good.empty())
+            {
+                reserved.kind = Kind::ALL;
+                return reserved;
+            }
+
+            // Keep whichever set is smaller
+            reserved.kind = Kind::SOME;
+            reserved.mask = depends;
+            reserved.list_bad = (bad.size() <= good.size());
+            reserved.values = reserved.list_bad ? std::move(bad) : std::move(good);
+            return reserved;
+        }
+
+      private:
+        static constexpr uint32_t NUM_SAMPLES = 1u << 14;
+        static constexpr uint32_t NUM_DEPENDENCY_SAMPLES = 1u << 12;
+    };
+
+} // namespace mavis
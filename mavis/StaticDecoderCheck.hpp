@@ -0,0 +1,256 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "DecoderConsts.h"
+#include "DecoderExceptions.h"
+#include "DecodeImage.hpp"
+#include "OpcodeInfo.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief An opcode a derived decoder (generated static decoder or DecodeImage) and the
+     * dynamic decoder disagree on. Outcomes are mnemonics, or "<illegal>" / "<unknown>"
+     */
+    struct StaticDecoderMismatch
+    {
+        Opcode icode;
+        std::string expected; // Dynamic (Mavis) decode
+        std::string actual;   // Derived decoder's decode
+    };
+
+    /**
+     * \brief Drift check for a decoder derived from a Mavis configuration: decode a set of
+     * opcodes with both the derived decoder and a Mavis built from the current JSON, and report
+     * any disagreement. The opcodes are the given example encodings, every single-bit variation
+     * of them, and num_random random 32-bit and 16-bit opcodes
+     * \param mavis Mavis instance configured for the ISA the decoder was derived from
+     * \param decode The derived decoder: opcode to mnemonic, "<illegal>" or "<unknown>"
+     * \param max_mismatches Stop after this many mismatches
+     */
+    template <typename MavisType, typename DecodeFunc, typename ExampleList>
+    std::vector<StaticDecoderMismatch>
+    checkDerivedDecoder(MavisType & mavis, const DecodeFunc & decode,
+                        const ExampleList & examples, const uint32_t num_random,
+                        const uint64_t seed = 1, const size_t max_mismatches = 16)
+    {
+        const auto dynamic_outcome = [&mavis](const Opcode icode) -> std::string
+        {
+            try
+            {
+                return mavis.getInfo(icode)->opinfo->getMnemonic();
+            }
+            catch (const IllegalOpcode &)
+            {
+                return "<illegal>";
+            }
+            catch (const UnknownOpcode &)
+            {
+                return "<unknown>";
+            }
+        };
+
+        std::vector<StaticDecoderMismatch> mismatches;
+        const auto check = [&](const Opcode icode)
+        {
+            if (mismatches.size() < max_mismatches)
+            {
+                std::string expected = dynamic_outcome(icode);
+                std::string actual = decode(icode);
+                if (expected != actual)
+                {
+                    mismatches.push_back({icode, std::move(expected), std::move(actual)});
+                }
+            }
+        };
+
+        for (const Opcode example : examples)
+        {
+            check(example);
+            for (uint32_t bit = 0; bit < 32; ++bit)
+            {
+                check(example ^ (1ull << bit));
+            }
+        }
+
+        std::mt19937_64 rng(seed);
+        for (uint32_t i = 0; i < num_random; ++i)
+        {
+            const Opcode icode = rng();
+            check(icode & 0xffffffffull);
+            check(icode & 0xffffull);
+        }
+        return mismatches;
+    }
+
+    /**
+     * \brief Drift check for a decoder generated by StaticDecoderWriter (see
+     * checkDerivedDecoder())
+     * \tparam StaticDecoder The generated struct
+     */
+    template <typename StaticDecoder, typename MavisType>
+    std::vector<StaticDecoderMismatch>
+    checkStaticDecoder(MavisType & mavis, const uint32_t num_random = 1u << 20,
+                       const uint64_t seed = 1, const size_t max_mismatches = 16)
+    {
+        const auto decode = [](const Opcode icode) -> std::string
+        {
+            const uint32_t index = StaticDecoder::decode(icode);
+            if (index == StaticDecoder::UNKNOWN)
+            {
+                return "<unknown>";
+            }
+            else if (index == StaticDecoder::ILLEGAL)
+            {
+                return "<illegal>";
+            }
+            return std::string(StaticDecoder::MNEMONICS[index]);
+        };
+        return checkDerivedDecoder(mavis, decode, StaticDecoder::EXAMPLES, num_random, seed,
+                                   max_mismatches);
+    }
+
+    /**
+     * \brief Drift check for the operand fields of a generated decoder: on the example encodings
+     * and num_random random 32-bit and 16-bit opcodes, every operand field of the decoded
+     * instruction must extract the register Mavis reports for that operand (and, for complete
+     * operand ranges, Mavis must report no other operands). Outcomes are
+     * "<mnemonic> <source|dest> <OperandFieldID> = <register>", or "<none>"
+     * \tparam StaticDecoder The generated struct
+     */
+    template <typename StaticDecoder, typename MavisType>
+    std::vector<StaticDecoderMismatch>
+    checkStaticDecoderOperands(MavisType & mavis, const uint32_t num_random = 1u << 16,
+                               const uint64_t seed = 1, const size_t max_mismatches = 16)
+    {
+        std::vector<StaticDecoderMismatch> mismatches;
+        const auto describe = [](const std::string & mnemonic, const bool is_dest,
+                                 const uint32_t field_id, const uint32_t value)
+        {
+            return mnemonic + (is_dest ? " dest " : " source ") + std::to_string(field_id) + " = "
+                   + std::to_string(value);
+        };
+
+        const auto check = [&](const Opcode icode)
+        {
+            const uint32_t index = StaticDecoder::decode(icode);
+            if ((index >= StaticDecoder::NUM_INSTS) || (mismatches.size() >= max_mismatches))
+            {
+                return;
+            }
+            OpcodeInfo::PtrType opinfo;
+            try
+            {
+                opinfo = mavis.getInfo(icode)->opinfo;
+            }
+            catch (const std::exception &)
+            {
+                return; // Mnemonic drift is checkStaticDecoder()'s to report
+            }
+            const std::string mnemonic(StaticDecoder::MNEMONICS[index]);
+            if (opinfo->getMnemonic() != mnemonic)
+            {
+                return;
+            }
+
+            const auto & range = StaticDecoder::OPERANDS[index];
+            for (uint32_t i = range.first; i < (range.first + range.count); ++i)
+            {
+                const auto & field = StaticDecoder::OPERAND_FIELDS[i];
+                const auto & olist = field.is_dest ? opinfo->getDestOpInfoList()
+                                                   : opinfo->getSourceOpInfoList();
+                const auto elem = std::find_if(
+                    olist.begin(), olist.end(), [&field](const auto & e)
+                    { return static_cast<uint32_t>(e.field_id) == field.field_id; });
+                const std::string actual =
+                    describe(mnemonic, field.is_dest, field.field_id, field.extract(icode));
+                if (elem == olist.end())
+                {
+                    mismatches.push_back({icode, "<none>", actual});
+                }
+                else if (elem->field_value != field.extract(icode))
+                {
+                    mismatches.push_back(
+                        {icode,
+                         describe(mnemonic, field.is_dest, field.field_id, elem->field_value),
+                         actual});
+                }
+            }
+            if (range.complete
+                && ((opinfo->getSourceOpInfoList().size() + opinfo->getDestOpInfoList().size())
+                    != range.count))
+            {
+                mismatches.push_back({icode, mnemonic + " with more operands",
+                                      mnemonic + " with " + std::to_string(range.count)});
+            }
+        };
+
+        for (const Opcode example : StaticDecoder::EXAMPLES)
+        {
+            check(example);
+        }
+        std::mt19937_64 rng(seed);
+        for (uint32_t i = 0; i < num_random; ++i)
+        {
+            const Opcode icode = rng();
+            check(icode & 0xffffffffull);
+            check(icode & 0xffffull);
+        }
+        return mismatches;
+    }
+
+    /**
+     * \brief Drift check for a DecodeImage (see checkDerivedDecoder())
+     */
+    template <typename MavisType>
+    std::vector<StaticDecoderMismatch>
+    checkDecodeImage(MavisType & mavis, const DecodeImage & image,
+                     const uint32_t num_random = 1u << 20, const uint64_t seed = 1,
+                     const size_t max_mismatches = 16)
+    {
+        const auto decode = [&image](const Opcode icode) -> std::string
+        {
+            const uint32_t index = image.decode(icode);
+            if (index == DecodeImage::UNKNOWN)
+            {
+                return "<unknown>";
+            }
+            else if (index == DecodeImage::ILLEGAL)
+            {
+                return "<illegal>";
+            }
+            return std::string(image.getMnemonic(index));
+        };
+        std::vector<Opcode> examples(image.getNumInsts());
+        for (uint32_t i = 0; i < examples.size(); ++i)
+        {
+            examples[i] = image.getExample(i);
+        }
+        return checkDerivedDecoder(mavis, decode, examples, num_random, seed, max_mismatches);
+    }
+
+    /**
+     * \brief UIDs, in a given Mavis instance, of the instructions of a generated decoder (indexed
+     * like StaticDecoder::MNEMONICS). INVALID_UID for mnemonics the instance does not know
+     */
+    template <typename StaticDecoder, typename MavisType>
+    std::array<InstructionUniqueID, StaticDecoder::NUM_INSTS>
+    mapStaticDecoderUIDs(const MavisType & mavis)
+    {
+        std::array<InstructionUniqueID, StaticDecoder::NUM_INSTS> uids;
+        for (uint32_t i = 0; i < StaticDecoder::NUM_INSTS; ++i)
+        {
+            uids[i] = mavis.lookupInstructionUniqueID(std::string(StaticDecoder::MNEMONICS[i]));
+        }
+        return uids;
+    }
+
+} // namespace mavis
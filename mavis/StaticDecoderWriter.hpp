@@ -0,0 +1,705 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "IFactory.h"
+#include "ReservedEncodings.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cinttypes>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mavis
+{
+
+    /**
+     * \brief Writes a decode trie out as a standalone C++ header: a struct whose constexpr
+     * decode() maps an opcode to an instruction index using switch statements and constexpr
+     * tables, with no dependency on Mavis at all
+     *
+     * The generated struct provides:
+     *   - decode(icode): instruction index, UNKNOWN, or ILLEGAL (reserved encodings that the
+     *     dynamic decoder rejects with IllegalOpcode)
+     *   - MNEMONICS[index]: the instruction's mnemonic
+     *   - UIDS[index]: its UID in the generating Mavis instance (only meaningful to a Mavis built
+     *     with the same UID list; otherwise map mnemonics to UIDs at startup)
+     *   - EXAMPLES[index]: an opcode with the fixed bits of its encoding (an input for drift
+     *     checks; a more specific encoding may take precedence over it)
+     *   - OPERANDS[index]: the instruction's register operands, as a range of OPERAND_FIELDS
+     *     (OperandFieldID, operand type, and the opcode field holding the register number)
+     *   - ANNOTATIONS[index]: index of the instruction's annotation object (instructions sharing
+     *     one share the index), or NO_ANNOTATION; ANNOTATION_OWNERS lists an instruction carrying
+     *     each annotation, to load them by mnemonic at startup
+     *
+     * Operand fields are found by probing the instruction's extractor: the opcode bits that
+     * change an operand's register, plus a constant (RVC's x8-x15 registers, implied registers).
+     * Operands that are not a single field (register lists) are left out and the instruction's
+     * operand range is marked incomplete. Immediates are not described. Use checkStaticDecoder()
+     * and checkStaticDecoderOperands() (StaticDecoderCheck.hpp) to guard a generated decoder
+     * against drift from the JSON it was generated from.
+     *
+     * Reserved encodings are resolved by ReservedEncodings::find() (ReservedEncodings.hpp).
+     */
+    template <typename InstType, typename AnnotationType> class StaticDecoderWriter
+    {
+      public:
+        using NodePtr = typename IFactoryIF<InstType, AnnotationType>::PtrType;
+        using NodeView = typename IFactoryIF<InstType, AnnotationType>::NodeView;
+        using Kind = typename NodeView::Kind;
+
+        /**
+         * \param class_name Name of the generated struct
+         * \param description Free-form text recorded in the header (e.g. the ISA string)
+         */
+        StaticDecoderWriter(const std::string & class_name, const std::string & description) :
+            class_name_(class_name),
+            description_(description)
+        {
+        }
+
+        void write(std::ostream & os, const NodePtr & root)
+        {
+            const std::string root_fn = emitNode_(root, Path());
+
+            std::ios_base::fmtflags os_state(os.flags());
+            os << "// Generated by mavis::StaticDecoderWriter. Do not edit." << std::endl;
+            os << "// " << description_ << std::endl;
+            os << "#pragma once" << std::endl << std::endl;
+            os << "#include <array>" << std::endl;
+            os << "#include <cstdint>" << std::endl;
+            os << "#include <string_view>" << std::endl << std::endl;
+            os << "struct " << class_name_ << std::endl << "{" << std::endl;
+            os << "    static constexpr uint32_t UNKNOWN = 0xffffffff;" << std::endl;
+            os << "    static constexpr uint32_t ILLEGAL = 0xfffffffe;" << std::endl;
+            os << "    static constexpr uint32_t NUM_INSTS = " << std::dec << insts_.size() << ";"
+               << std::endl;
+            os << "    static constexpr std::string_view DESCRIPTION = \"" << description_ << "\";"
+               << std::endl
+               << std::endl;
+
+            os << "    static constexpr std::array<std::string_view, NUM_INSTS> MNEMONICS = {"
+               << std::endl;
+            for (const auto & inst : insts_)
+            {
+                os << "        \"" << inst.mnemonic << "\"," << std::endl;
+            }
+            os << "    };" << std::endl << std::endl;
+
+            os << "    static constexpr std::array<uint32_t, NUM_INSTS> UIDS = {" << std::endl;
+            for (const auto & inst : insts_)
+            {
+                os << "        " << std::dec << inst.uid << "," << std::endl;
+            }
+            os << "    };" << std::endl << std::endl;
+
+            os << "    static constexpr std::array<uint64_t, NUM_INSTS> EXAMPLES = {" << std::endl;
+            for (const auto & inst : insts_)
+            {
+                os << "        " << hex_(inst.example) << "," << std::endl;
+            }
+            os << "    };" << std::endl << std::endl;
+
+            writeOperands_(os);
+            writeAnnotations_(os);
+
+            os << "    static constexpr uint32_t decode(const uint64_t icode) { return " << root_fn
+               << "(icode); }" << std::endl
+               << std::endl;
+            os << "  private:" << std::endl;
+            os << body_.str();
+            os << "};" << std::endl;
+            os.flags(os_state);
+        }
+
+      private:
+        using Path = DecodePath;
+
+        // A register operand held in an opcode field: ((icode >> shift) & mask) + offset
+        struct OperandField
+        {
+            InstMetaData::OperandFieldID field_id;
+            InstMetaData::OperandTypes operand_type;
+            bool is_dest;
+            uint32_t shift;
+            uint32_t mask;
+            uint32_t offset;
+
+            uint32_t extract(const Opcode icode) const
+            {
+                return static_cast<uint32_t>((icode >> shift) & mask) + offset;
+            }
+        };
+
+        struct Inst
+        {
+            std::string mnemonic;
+            InstructionUniqueID uid;
+            Opcode example;
+            uint32_t first_operand;
+            uint32_t num_operands;
+            bool operands_complete;
+            uint32_t annotation;
+        };
+
+        static constexpr uint32_t NO_ANNOTATION = 0xffffffff;
+        static constexpr uint32_t NUM_OPERAND_SAMPLES = 64;
+
+        const std::string class_name_;
+        const std::string description_;
+        std::vector<Inst> insts_;
+        std::unordered_map<std::string, uint32_t> inst_index_;
+        std::unordered_map<const void*, std::string> node_fns_;
+        std::vector<OperandField> operand_fields_;
+        std::unordered_map<const void*, uint32_t> annotation_index_;
+        std::vector<uint32_t> annotation_owners_;
+        std::ostringstream body_;
+        uint32_t next_id_ = 0;
+        std::mt19937_64 rng_{0x6d61766973ull};
+
+        static std::string hex_(const Opcode value)
+        {
+            std::ostringstream ss;
+            ss << "0x" << std::hex << value;
+            return ss.str();
+        }
+
+        template <typename AnnotationPtrType>
+        uint32_t instIndex_(const std::string & mnemonic, const InstructionUniqueID uid,
+                            const Path & path, const ExtractorIF::PtrType & extractor,
+                            const InstMetaData::PtrType & meta, const AnnotationPtrType & anno)
+        {
+            const auto [itr, inserted] = inst_index_.emplace(mnemonic, insts_.size());
+            if (inserted)
+            {
+                Inst inst{mnemonic, uid, path.example(), 0, 0, true, NO_ANNOTATION};
+                inst.first_operand = operand_fields_.size();
+                inst.operands_complete = findOperandFields_(extractor, meta, path);
+                inst.num_operands = operand_fields_.size() - inst.first_operand;
+                if (anno != nullptr)
+                {
+                    const auto [aitr, new_anno] =
+                        annotation_index_.emplace(anno.get(), annotation_owners_.size());
+                    if (new_anno)
+                    {
+                        annotation_owners_.push_back(insts_.size());
+                    }
+                    inst.annotation = aitr->second;
+                }
+                insts_.push_back(inst);
+            }
+            return itr->second;
+        }
+
+        // Extract an opcode; false for reserved encodings and opcodes the extractor rejects
+        static bool tryExtract_(const ExtractorIF::PtrType & extractor,
+                                const InstMetaData::PtrType & meta, const Opcode icode,
+                                ExtractorIF::ExtractedFields & fields)
+        {
+            try
+            {
+                if (extractor->isIllop(icode))
+                {
+                    return false;
+                }
+                extractor->extractAll(icode, meta, fields);
+                return true;
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+        }
+
+        static std::optional<uint32_t> findOperand_(const ExtractorIF::ExtractedFields & fields,
+                                                    const bool is_dest,
+                                                    const InstMetaData::OperandFieldID field_id)
+        {
+            const OperandInfo & olist = is_dest ? fields.dest_opinfo : fields.source_opinfo;
+            for (const auto & elem : olist.getElements())
+            {
+                if (elem.field_id == field_id)
+                {
+                    return elem.field_value;
+                }
+            }
+            return std::nullopt;
+        }
+
+        // Appends the register operands of an instruction reached by path to operand_fields_.
+        // An extractor reads its form's fields wherever they are, so each opcode bit is flipped
+        // to find the bits an operand depends on, and the resulting field is then checked
+        // against random opcodes. Returns false if an operand is not a single field (it is left
+        // out)
+        bool findOperandFields_(const ExtractorIF::PtrType & extractor,
+                                const InstMetaData::PtrType & meta, const Path & path)
+        {
+            const Opcode width_mask = ((path.example() & 0x3) == 0x3) ? 0xffffffffull : 0xffffull;
+
+            // The example may be a reserved encoding (e.g. c.addi4spn with a zero immediate)
+            Opcode example = path.example();
+            ExtractorIF::ExtractedFields base;
+            for (uint32_t i = 0; !tryExtract_(extractor, meta, example, base); ++i)
+            {
+                if (i == NUM_OPERAND_SAMPLES)
+                {
+                    return false;
+                }
+                base = ExtractorIF::ExtractedFields();
+                example = path.example() ^ (rng_() & width_mask);
+            }
+
+            std::vector<ExtractorIF::ExtractedFields> flipped;
+            std::vector<Opcode> flipped_bits;
+            for (Opcode bits = width_mask; bits != 0; bits &= bits - 1)
+            {
+                const Opcode bit = bits & -bits;
+                ExtractorIF::ExtractedFields fields;
+                if (tryExtract_(extractor, meta, example ^ bit, fields))
+                {
+                    flipped.emplace_back(std::move(fields));
+                    flipped_bits.push_back(bit);
+                }
+            }
+
+            std::vector<std::pair<Opcode, ExtractorIF::ExtractedFields>> samples;
+            for (uint32_t i = 0; i < NUM_OPERAND_SAMPLES; ++i)
+            {
+                const Opcode icode = example ^ (rng_() & width_mask);
+                ExtractorIF::ExtractedFields fields;
+                if (tryExtract_(extractor, meta, icode, fields))
+                {
+                    samples.emplace_back(icode, std::move(fields));
+                }
+            }
+
+            bool complete = true;
+            for (const bool is_dest : {false, true})
+            {
+                const OperandInfo & olist = is_dest ? base.dest_opinfo : base.source_opinfo;
+                for (const auto & elem : olist.getElements())
+                {
+                    Opcode depends = 0;
+                    for (uint32_t i = 0; i < flipped.size(); ++i)
+                    {
+                        if (findOperand_(flipped[i], is_dest, elem.field_id) != elem.field_value)
+                        {
+                            depends |= flipped_bits[i];
+                        }
+                    }
+
+                    const uint32_t shift = (depends == 0) ? 0 : std::countr_zero(depends);
+                    const uint32_t len = std::popcount(depends);
+                    const Opcode mask = (len == 0) ? 0 : ((1ull << len) - 1);
+                    bool is_field = ((depends >> shift) == mask)
+                                    && (static_cast<uint32_t>(elem.field_id) <= 0xff)
+                                    && (static_cast<uint32_t>(elem.operand_type) <= 0xff);
+                    const OperandField field{
+                        elem.field_id,
+                        elem.operand_type,
+                        is_dest,
+                        shift,
+                        static_cast<uint32_t>(mask),
+                        elem.field_value - static_cast<uint32_t>((example >> shift) & mask)};
+                    for (const auto & [icode, fields] : samples)
+                    {
+                        is_field = is_field
+                                   && (findOperand_(fields, is_dest, elem.field_id)
+                                       == field.extract(icode));
+                    }
+
+                    if (is_field)
+                    {
+                        operand_fields_.push_back(field);
+                    }
+                    complete = complete && is_field;
+                }
+            }
+            return complete;
+        }
+
+        void writeOperands_(std::ostream & os) const
+        {
+            os << "    // A register operand: OperandFieldID and OperandTypes are the values of the"
+               << std::endl;
+            os << "    // mavis::InstMetaData enums. The register is ((icode >> shift) & mask) + "
+                  "offset; mask"
+               << std::endl;
+            os << "    // is 0 for registers the opcode implies (e.g. the link register of c.jal)"
+               << std::endl;
+            os << "    struct OperandField" << std::endl << "    {" << std::endl;
+            os << "        uint8_t field_id;" << std::endl;
+            os << "        uint8_t operand_type;" << std::endl;
+            os << "        bool is_dest;" << std::endl;
+            os << "        uint8_t shift;" << std::endl;
+            os << "        uint32_t mask;" << std::endl;
+            os << "        uint32_t offset;" << std::endl << std::endl;
+            os << "        constexpr uint32_t extract(const uint64_t icode) const" << std::endl;
+            os << "        {" << std::endl;
+            os << "            return static_cast<uint32_t>((icode >> shift) & mask) + offset;"
+               << std::endl;
+            os << "        }" << std::endl;
+            os << "    };" << std::endl << std::endl;
+
+            os << "    // OPERANDS[index]: entries [first, first + count) of OPERAND_FIELDS, "
+                  "sources first. complete"
+               << std::endl;
+            os << "    // is false if some operands are not a single field (decode those with "
+                  "Mavis)"
+               << std::endl;
+            os << "    struct OperandRange" << std::endl << "    {" << std::endl;
+            os << "        uint32_t first;" << std::endl;
+            os << "        uint32_t count;" << std::endl;
+            os << "        bool complete;" << std::endl;
+            os << "    };" << std::endl << std::endl;
+
+            os << "    static constexpr uint32_t NUM_OPERAND_FIELDS = " << std::dec
+               << operand_fields_.size() << ";" << std::endl
+               << std::endl;
+            os << "    static constexpr std::array<OperandField, NUM_OPERAND_FIELDS> "
+                  "OPERAND_FIELDS = {{"
+               << std::endl;
+            for (const auto & field : operand_fields_)
+            {
+                os << "        {" << std::dec << static_cast<uint32_t>(field.field_id) << ", "
+                   << static_cast<uint32_t>(field.operand_type) << ", "
+                   << (field.is_dest ? "true" : "false") << ", " << field.shift << ", "
+                   << hex_(field.mask) << ", " << std::dec << field.offset << "}," << std::endl;
+            }
+            os << "    }};" << std::endl << std::endl;
+
+            os << "    static constexpr std::array<OperandRange, NUM_INSTS> OPERANDS = {{"
+               << std::endl;
+            for (const auto & inst : insts_)
+            {
+                os << "        {" << std::dec << inst.first_operand << ", " << inst.num_operands
+                   << ", " << (inst.operands_complete ? "true" : "false") << "}, // "
+                   << inst.mnemonic << std::endl;
+            }
+            os << "    }};" << std::endl << std::endl;
+        }
+
+        void writeAnnotations_(std::ostream & os) const
+        {
+            os << "    static constexpr uint32_t NO_ANNOTATION = " << hex_(NO_ANNOTATION) << ";"
+               << std::endl;
+            os << "    static constexpr uint32_t NUM_ANNOTATIONS = " << std::dec
+               << annotation_owners_.size() << ";" << std::endl
+               << std::endl;
+            os << "    static constexpr std::array<uint32_t, NUM_INSTS> ANNOTATIONS = {"
+               << std::endl;
+            for (const auto & inst : insts_)
+            {
+                os << "        "
+                   << ((inst.annotation == NO_ANNOTATION) ? std::string("NO_ANNOTATION")
+                                                          : std::to_string(inst.annotation))
+                   << "," << std::endl;
+            }
+            os << "    };" << std::endl << std::endl;
+
+            os << "    static constexpr std::array<uint32_t, NUM_ANNOTATIONS> ANNOTATION_OWNERS = {"
+               << std::endl;
+            for (const uint32_t owner : annotation_owners_)
+            {
+                os << "        " << std::dec << owner << "," << std::endl;
+            }
+            os << "    };" << std::endl << std::endl;
+        }
+
+        std::string result_(const uint32_t index) const
+        {
+            return std::to_string(index) + "; // " + insts_[index].mnemonic;
+        }
+
+        std::string emitNode_(const NodePtr & node, const Path & path)
+        {
+            if (node == nullptr)
+            {
+                return "";
+            }
+            if (const auto itr = node_fns_.find(node.get()); itr != node_fns_.end())
+            {
+                return itr->second;
+            }
+            const std::string fn = "node" + std::to_string(next_id_++) + "_";
+            node_fns_.emplace(node.get(), fn);
+
+            const NodeView view = node->getView();
+            std::ostringstream code;
+            switch (view.kind)
+            {
+                case Kind::FIELD:
+                    emitField_(code, fn, view, path);
+                    break;
+                case Kind::MATCH_LIST:
+                    emitMatchList_(code, fn, view, path);
+                    break;
+                case Kind::MATCH:
+                    emitMatch_(code, fn, view, path);
+                    break;
+                case Kind::SPECIAL_CASE:
+                    emitSpecialCase_(code, fn, view, path);
+                    break;
+                default:
+                    throw std::invalid_argument("StaticDecoderWriter: unsupported trie node '"
+                                                + node->getName() + "'");
+            }
+            body_ << code.str();
+            return fn;
+        }
+
+        // Children by field value; the default is also tried when a child does not know the
+        // opcode (IFactoryDenseComposite::getInfo())
+        void emitField_(std::ostream & code, const std::string & fn, const NodeView & view,
+                        const Path & path)
+        {
+            const Opcode fmask = view.field->getShiftedMask();
+            std::map<uint64_t, std::vector<Opcode>> values_by_index;
+            for (const Opcode value : enumerateOpcodeBits(fmask))
+            {
+                values_by_index[view.field->extract(value)].push_back(value);
+            }
+
+            std::vector<std::pair<std::vector<Opcode>, std::string>> cases;
+            for (const auto & [index, child] : view.children)
+            {
+                const auto itr = values_by_index.find(index);
+                if ((child == nullptr) || (itr == values_by_index.end()))
+                {
+                    continue;
+                }
+                cases.emplace_back(itr->second,
+                                   emitNode_(child, path.restrict(fmask, itr->second.front())));
+            }
+            const std::string dflt = emitNode_(view.dflt, path);
+
+            code << "    static constexpr uint32_t " << fn << "(const uint64_t icode)"
+                 << std::endl;
+            code << "    {" << std::endl;
+            code << "        switch (icode & " << hex_(fmask) << ")" << std::endl;
+            code << "        {" << std::endl;
+            for (const auto & [values, child_fn] : cases)
+            {
+                for (const Opcode value : values)
+                {
+                    code << "            case " << hex_(value) << ":" << std::endl;
+                }
+                if (dflt.empty())
+                {
+                    code << "                return " << child_fn << "(icode);" << std::endl;
+                }
+                else
+                {
+                    code << "                if (const uint32_t r = " << child_fn
+                         << "(icode); r != UNKNOWN)" << std::endl;
+                    code << "                {" << std::endl;
+                    code << "                    return r;" << std::endl;
+                    code << "                }" << std::endl;
+                    code << "                break;" << std::endl;
+                }
+            }
+            code << "            default:" << std::endl;
+            code << "                break;" << std::endl;
+            code << "        }" << std::endl;
+            code << "        return " << (dflt.empty() ? "UNKNOWN" : dflt + "(icode)") << ";"
+                 << std::endl;
+            code << "    }" << std::endl << std::endl;
+        }
+
+        // The matcher is selected by a lookup table on the bits the matchers look at
+        void emitMatchList_(std::ostream & code, const std::string & fn, const NodeView & view,
+                            const Path & path)
+        {
+            const std::vector<Opcode> select_values = enumerateOpcodeBits(view.mask);
+            std::vector<uint32_t> selected(select_values.size());
+            std::vector<Path> child_paths(view.children.size(), path);
+            for (uint32_t i = 0; i < select_values.size(); ++i)
+            {
+                selected[i] = view.select(select_values[i]);
+                if (selected[i] < view.children.size())
+                {
+                    child_paths[selected[i]].select_mask = view.mask;
+                    child_paths[selected[i]].select_values.push_back(select_values[i]);
+                }
+            }
+
+            // Table index: the select bits, packed run by run from the low end
+            std::ostringstream index_expr;
+            uint32_t pos = 0;
+            Opcode remaining = view.mask;
+            while (remaining != 0)
+            {
+                const uint32_t shift = std::countr_zero(remaining);
+                const uint32_t len = std::countr_one(remaining >> shift);
+                const Opcode run_mask = (len == 64) ? ~0ull : ((1ull << len) - 1);
+                index_expr << ((pos == 0) ? "" : " | ") << "(((icode >> " << shift << ") & "
+                           << hex_(run_mask) << ") << " << pos << ")";
+                remaining &= ~(run_mask << shift);
+                pos += len;
+            }
+
+            std::vector<std::string> child_fns;
+            for (uint32_t i = 0; i < view.children.size(); ++i)
+            {
+                const NodePtr & child = view.children[i].second;
+                child_fns.emplace_back((child != nullptr) ? emitNode_(child, child_paths[i])
+                                                          : emitNode_(view.dflt, child_paths[i]));
+            }
+
+            code << "    static constexpr uint8_t " << fn << "table_[" << std::dec
+                 << select_values.size() << "] = {";
+            for (uint32_t i = 0; i < select_values.size(); ++i)
+            {
+                // select_values enumerates the select bits in the same order as the packed index
+                code << ((i % 32 == 0) ? "\n        " : " ") << selected[i] << ",";
+            }
+            code << std::endl << "    };" << std::endl << std::endl;
+
+            code << "    static constexpr uint32_t " << fn << "(const uint64_t icode)"
+                 << std::endl;
+            code << "    {" << std::endl;
+            code << "        switch (" << fn << "table_[" << index_expr.str() << "])" << std::endl;
+            code << "        {" << std::endl;
+            for (uint32_t i = 0; i < child_fns.size(); ++i)
+            {
+                if (!child_fns[i].empty())
+                {
+                    code << "            case " << i << ":" << std::endl;
+                    code << "                return " << child_fns[i] << "(icode);" << std::endl;
+                }
+            }
+            code << "            default:" << std::endl;
+            code << "                return UNKNOWN;" << std::endl;
+            code << "        }" << std::endl;
+            code << "    }" << std::endl << std::endl;
+        }
+
+        void emitMatch_(std::ostream & code, const std::string & fn, const NodeView & view,
+                        const Path & path)
+        {
+            const std::string child_fn =
+                emitNode_(view.children.front().second, path.restrict(view.mask, view.value));
+            code << "    static constexpr uint32_t " << fn << "(const uint64_t icode)"
+                 << std::endl;
+            code << "    {" << std::endl;
+            code << "        return ((icode & " << hex_(view.mask) << ") == " << hex_(view.value)
+                 << ") ? " << child_fn << "(icode) : UNKNOWN;" << std::endl;
+            code << "    }" << std::endl << std::endl;
+        }
+
+        // First matching case wins; reserved encodings and overlays are resolved in the leaf
+        // (IFactorySpecialCaseComposite::getInfo() and IFactory::getInfo())
+        void emitSpecialCase_(std::ostream & code, const std::string & fn, const NodeView & view,
+                              const Path & path)
+        {
+            code << "    static constexpr uint32_t " << fn << "(const uint64_t icode)"
+                 << std::endl;
+            code << "    {" << std::endl;
+            for (const auto & scase : view.cases)
+            {
+                code << "        if ((icode & " << hex_(scase.mask) << ") == " << hex_(scase.value)
+                     << ")" << std::endl;
+                code << "        {" << std::endl;
+                emitLeaf_(code, scase, path.restrict(scase.mask, scase.value), "            ");
+                code << "        }" << std::endl;
+            }
+            if (view.default_case)
+            {
+                emitLeaf_(code, *view.default_case, path, "        ");
+            }
+            else
+            {
+                code << "        return UNKNOWN;" << std::endl;
+            }
+            code << "    }" << std::endl << std::endl;
+        }
+
+        void emitLeaf_(std::ostream & code, const typename NodeView::Case & scase,
+                       const Path & path, const std::string & indent)
+        {
+            const auto leaf = std::dynamic_pointer_cast<IFactory<InstType, AnnotationType>>(
+                mavis::utils::notNull(scase.factory));
+            if (leaf == nullptr) [[unlikely]]
+            {
+                throw std::invalid_argument("StaticDecoderWriter: special case '"
+                                            + scase.mnemonic + "' does not lead to a leaf");
+            }
+            const auto handle = leaf->prepareDirect(scase.mnemonic);
+            const uint32_t base = instIndex_(scase.mnemonic, handle.getUID(), path,
+                                             scase.extractor, handle.getMetaData(),
+                                             handle.getAnnotation());
+
+            emitIllegalCheck_(code, scase.extractor, path, indent);
+
+            // Only the first matching overlay is considered, and only if it overlays this
+            // mnemonic
+            for (const auto & olay : leaf->getOverlays())
+            {
+                const Path olay_path = path.restrict(olay->getMatchMask(), olay->getMatchValue());
+                code << indent << "if ((icode & " << hex_(olay->getMatchMask())
+                     << ") == " << hex_(olay->getMatchValue()) << ")" << std::endl;
+                code << indent << "{" << std::endl;
+                if (olay->getBaseMnemonic() == scase.mnemonic)
+                {
+                    if (olay->getExtractor() != nullptr)
+                    {
+                        emitIllegalCheck_(code, olay->getExtractor(), olay_path, indent + "    ");
+                    }
+                    const ExtractorIF::PtrType olay_extractor = (olay->getExtractor() != nullptr)
+                                                                    ? olay->getExtractor()
+                                                                    : scase.extractor;
+                    code << indent << "    return "
+                         << result_(instIndex_(olay->getMnemonic(), olay->getUID(), olay_path,
+                                               olay_extractor, olay->getMetaData(),
+                                               olay->getAnnotation()))
+                         << std::endl;
+                }
+                else
+                {
+                    code << indent << "    return " << result_(base) << std::endl;
+                }
+                code << indent << "}" << std::endl;
+            }
+            code << indent << "return " << result_(base) << std::endl;
+        }
+
+        // Emits "return ILLEGAL" for the reserved encodings of an extractor among the opcodes
+        // reaching path
+        void emitIllegalCheck_(std::ostream & code, const ExtractorIF::PtrType & extractor,
+                               const Path & path, const std::string & indent)
+        {
+            const ReservedEncodings reserved = ReservedEncodings::find(extractor, path, rng_);
+            if (reserved.kind == ReservedEncodings::Kind::NONE)
+            {
+                return;
+            }
+            if (reserved.kind == ReservedEncodings::Kind::ALL)
+            {
+                code << indent << "return ILLEGAL;" << std::endl;
+                return;
+            }
+
+            code << indent << "switch (icode & " << hex_(reserved.mask) << ")" << std::endl;
+            code << indent << "{" << std::endl;
+            for (const Opcode value : reserved.values)
+            {
+                code << indent << "    case " << hex_(value) << ":" << std::endl;
+            }
+            code << indent << "        " << (reserved.list_bad ? "return ILLEGAL;" : "break;")
+                 << std::endl;
+            code << indent << "    default:" << std::endl;
+            code << indent << "        " << (reserved.list_bad ? "break;" : "return ILLEGAL;")
+                 << std::endl;
+            code << indent << "}" << std::endl;
+        }
+    };
+
+} // namespace mavis
@@ -6,6 +6,8 @@
 
 #include <boost/core/demangle.hpp>
 
+#include "RefPtr.hpp"
+
 namespace mavis::utils
 {
     template <typename ValType, typename OtherValType>
@@ -81,6 +83,18 @@ namespace mavis::utils
         return p;
     }
 
+#ifdef MAVIS_SINGLE_THREADED
+    template <typename T> inline const RefPtr<T> & notNull(const RefPtr<T> & p)
+    {
+        if (p == nullptr) [[unlikely]]
+        {
+            throw std::runtime_error("notNull: pointer was null: "
+                                     + boost::core::demangle(typeid(T).name()));
+        }
+        return p;
+    }
+#endif
+
     template <typename T> struct smart_ptr_traits
     {
         // This condition will always evaluate to false. static_assert(false...) does not work
@@ -100,6 +114,19 @@ namespace mavis::utils
         }
     };
 
+#ifdef MAVIS_SINGLE_THREADED
+    template <typename T> struct smart_ptr_traits<RefPtr<T>>
+    {
+        using ptr_type = RefPtr<T>;
+        using element_type = typename ptr_type::element_type;
+
+        template <typename U, typename... Args> static ptr_type construct(Args... args)
+        {
+            return makeShared<U>(std::forward<Args>(args)...);
+        }
+    };
+#endif
+
     template <typename T, typename Deleter> struct smart_ptr_traits<std::unique_ptr<T, Deleter>>
     {
         using ptr_type = std::unique_ptr<T, Deleter>;
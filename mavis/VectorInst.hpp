@@ -0,0 +1,446 @@
+#pragma once
+
+#include "DecoderTypes.h"
+#include "DecoderConsts.h"
+#include "OpcodeInfo.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <string>
+#include <type_traits>
+
+namespace mavis
+{
+
+    /**
+     * \brief Fields of a vtype value (vsetvl*'s immediate/register operand, or the vtype CSR)
+     */
+    struct VType
+    {
+        static constexpr uint64_t VLMUL_MASK = 0x7;
+        static constexpr uint64_t VSEW_MASK = 0x38;
+        static constexpr uint64_t VSEW_SHIFT = 3;
+        static constexpr uint64_t VTA = 0x40;
+        static constexpr uint64_t VMA = 0x80;
+        static constexpr uint64_t DEFINED_BITS = 0xff;
+
+        uint16_t sew = 0;     // Selected element width, in bits
+        int8_t lmul_log2 = 0; // log2(LMUL), -3 (mf8) through 3 (m8)
+        bool vta = false;
+        bool vma = false;
+        bool legal = false; // False if vill (or any other bit above vma) is set, or reserved
+
+        static constexpr VType decode(const uint64_t vtype)
+        {
+            VType vt;
+            const uint64_t vlmul = vtype & VLMUL_MASK;
+            const uint64_t vsew = (vtype & VSEW_MASK) >> VSEW_SHIFT;
+            vt.sew = 8u << vsew;
+            vt.lmul_log2 = (vlmul < 4) ? static_cast<int8_t>(vlmul)
+                                       : static_cast<int8_t>(static_cast<int>(vlmul) - 8);
+            vt.vta = (vtype & VTA) != 0;
+            vt.vma = (vtype & VMA) != 0;
+            vt.legal = ((vtype & ~DEFINED_BITS) == 0) && (vsew < 4) && (vlmul != 4);
+            return vt;
+        }
+    };
+
+    /**
+     * \brief Vector register groups and element parameters of an RVV instruction under a given
+     * vtype
+     *
+     * The OpcodeInfo of a vector instruction names only the base register of each operand.
+     * VectorInst resolves those against vtype: the EEW and EMUL of every operand (LMUL groups,
+     * widening and narrowing, zero/sign extension, indexed and segment accesses, whole register
+     * accesses, mask and scalar-element operands), a register mask for each group, and whether
+     * v0 is read as a mask or carry. The src/dest masks are what a dependency tracker needs;
+     * getBodyMask() narrows an operand to the registers holding elements below a given vl.
+     *
+     * Obtain one with Mavis::decodeVector(), which caches them per (opcode, vtype).
+     *
+     * Operand roles are derived from the instruction type bits plus the RVV mnemonic
+     * conventions (the ".w*" forms have a 2*SEW vs2, ".vs" is a reduction, ".mm" and ".m" take
+     * mask operands, ...). Illegal EEW/EMUL combinations and misaligned groups are reported in
+     * status; ELEN limits and the operand overlap rules are not checked.
+     */
+    struct VectorInst
+    {
+        using InstructionTypes = InstMetaData::InstructionTypes;
+        using OperandFieldID = InstMetaData::OperandFieldID;
+        using OperandTypes = InstMetaData::OperandTypes;
+        using SpecialField = InstMetaData::SpecialField;
+
+        static constexpr uint8_t NO_REG = 0xff;
+        static constexpr uint32_t NUM_VREGS = 32;
+        static constexpr uint32_t MAX_GROUP_REGS = 8;
+
+        enum class Status : uint8_t
+        {
+            OK,
+            ILLEGAL_VTYPE,   // vill set, or a reserved SEW/LMUL
+            ILLEGAL_EEW,     // An operand's EEW/EMUL (or segment size) is out of range
+            MISALIGNED_GROUP // A group's base register is not a multiple of its size
+        };
+
+        // Index of each operand in operands[]
+        enum OperandIndex : uint8_t
+        {
+            VD = 0,
+            VS1,
+            VS2,
+            VS3,
+            NUM_OPERANDS
+        };
+
+        struct Operand
+        {
+            uint8_t base = NO_REG;
+            uint8_t num_fields = 0;     // Segment fields (NFIELDS); 1 for everything else
+            uint8_t regs_per_field = 0; // EMUL, or 1 when EMUL is fractional
+            int8_t emul_log2 = 0;
+            uint16_t eew = 0;  // Element width in bits; 1 for a mask operand
+            uint32_t mask = 0; // One bit per register of the group (all fields)
+
+            bool isValid() const { return base != NO_REG; }
+
+            uint32_t getNumRegs() const { return num_fields * regs_per_field; }
+        };
+
+        InstructionUniqueID uid = INVALID_UID;
+        VType vtype;
+        Operand operands[NUM_OPERANDS];
+        uint32_t src_mask = 0;  // Every vector register read, v0 included when used
+        uint32_t dest_mask = 0; // Every vector register written
+        Status status = Status::OK;
+        bool vector = false;       // False for non-vector instructions (nothing else is set)
+        bool masked = false;       // Masked by v0 (vm=0)
+        bool uses_v0 = false;      // Reads v0, as a mask or as carry-in/merge selector
+        bool vd_is_source = false; // vd is read (multiply-add, slides, ...)
+        bool ignores_vl = false;   // Whole register loads, stores and moves
+
+        bool isLegal() const { return status == Status::OK; }
+
+        const Operand & getOperand(OperandIndex idx) const { return operands[idx]; }
+
+        /**
+         * \brief True if elements of vd not written by the instruction (tail elements, or
+         * masked-off elements) keep their old values, making the old vd an input as well
+         */
+        bool preservesVd() const
+        {
+            return vector && !ignores_vl && operands[VD].isValid()
+                   && (!vtype.vta || (masked && !vtype.vma));
+        }
+
+        /**
+         * \brief Registers of an operand holding elements [0, vl), for a VLEN of vlen bits.
+         * Whole register operands ignore vl
+         */
+        uint32_t getBodyMask(const OperandIndex idx, const uint64_t vl, const uint32_t vlen) const
+        {
+            const Operand & op = operands[idx];
+            if (!op.isValid() || ignores_vl)
+            {
+                return op.mask;
+            }
+            if (vl == 0)
+            {
+                return 0;
+            }
+            const uint64_t used = (vl * op.eew + vlen - 1) / vlen;
+            const uint32_t touched = std::min<uint64_t>(op.regs_per_field, used);
+            uint32_t mask = 0;
+            for (uint32_t field = 0; field < op.num_fields; ++field)
+            {
+                mask |= groupMask_(op.base + field * op.regs_per_field, touched);
+            }
+            return mask;
+        }
+
+        /**
+         * \brief Resolve the vector operands of opinfo under vtype
+         */
+        static VectorInst build(const OpcodeInfo & opinfo, const uint64_t vtype)
+        {
+            VectorInst inst;
+            inst.uid = opinfo.getInstructionUniqueID();
+            inst.vtype = VType::decode(vtype);
+            if (!opinfo.isInstType(InstructionTypes::VECTOR))
+            {
+                return inst;
+            }
+            inst.vector = true;
+
+            const auto & sfields = opinfo.getSpecialFields();
+            const bool vm_clear = sfields.contains(SpecialField::VM)
+                                  && (sfields.at(SpecialField::VM) == 0);
+            const uint32_t nfields =
+                sfields.contains(SpecialField::NF) ? (sfields.at(SpecialField::NF) + 1) : 1;
+
+            Rule rules[NUM_OPERANDS];
+            const bool needs_vtype = classify_(opinfo, nfields, inst, rules);
+            if (needs_vtype && !inst.vtype.legal)
+            {
+                inst.status = Status::ILLEGAL_VTYPE;
+                return inst;
+            }
+
+            // Carry-in/merge forms (.vvm, .vxm, .vim, .vfm) read v0 unless their vm bit is set
+            const std::string & mnemonic = opinfo.getMnemonic();
+            const std::string suffix = mnemonic.substr(mnemonic.rfind('.') + 1);
+            const bool carry = (suffix.size() == 3) && (suffix.back() == 'm');
+            inst.masked = !carry && opinfo.isInstType(InstructionTypes::MASKABLE) && vm_clear;
+            inst.uses_v0 =
+                inst.masked || (carry && (vm_clear || !sfields.contains(SpecialField::VM)));
+            if (inst.uses_v0)
+            {
+                inst.src_mask |= 1u;
+            }
+
+            for (const auto & elem : opinfo.getSourceOpInfoList())
+            {
+                if (const auto idx = getIndex_(elem); idx != NUM_OPERANDS)
+                {
+                    inst.src_mask |= inst.resolve_(idx, elem.field_value, rules[idx]);
+                    inst.vd_is_source |= (idx == VD);
+                }
+            }
+            for (const auto & elem : opinfo.getDestOpInfoList())
+            {
+                if (const auto idx = getIndex_(elem); idx != NUM_OPERANDS)
+                {
+                    inst.dest_mask |= inst.resolve_(idx, elem.field_value, rules[idx]);
+                }
+            }
+            return inst;
+        }
+
+      private:
+        // How an operand's register group is shaped
+        struct Rule
+        {
+            enum Kind : uint8_t
+            {
+                GROUP,      // EMUL = EEW / SEW * LMUL
+                SINGLE,     // One register (a scalar element, or one element group)
+                MASK,       // One register of mask bits
+                FIXED_REGS, // A fixed number of registers, independent of vtype
+            };
+
+            Kind kind = GROUP;
+            uint16_t eew = 0;
+            uint8_t num_regs = 1; // FIXED_REGS only
+            uint8_t num_fields = 1;
+        };
+
+        static uint32_t groupMask_(const uint32_t base, const uint32_t num_regs)
+        {
+            return static_cast<uint32_t>(((1ull << num_regs) - 1) << base);
+        }
+
+        static OperandIndex getIndex_(const OperandInfo::Element & elem)
+        {
+            if (elem.operand_type != OperandTypes::VECTOR)
+            {
+                return NUM_OPERANDS;
+            }
+            switch (elem.field_id)
+            {
+                case OperandFieldID::RD:
+                    return VD;
+                case OperandFieldID::RS1:
+                    return VS1;
+                case OperandFieldID::RS2:
+                    return VS2;
+                case OperandFieldID::RS3:
+                    return VS3;
+                default:
+                    return NUM_OPERANDS;
+            }
+        }
+
+        static int8_t log2_(uint32_t value)
+        {
+            int8_t result = 0;
+            while (value > 1)
+            {
+                value >>= 1;
+                ++result;
+            }
+            return result;
+        }
+
+        /**
+         * \brief Fill in the shape of each operand
+         * \return false if the shapes do not depend on vtype
+         */
+        static bool classify_(const OpcodeInfo & opinfo, const uint32_t nfields,
+                              VectorInst & inst, Rule (&rules)[NUM_OPERANDS])
+        {
+            const uint16_t sew = inst.vtype.sew;
+            for (auto & rule : rules)
+            {
+                rule.eew = sew;
+            }
+
+            if (opinfo.isInstTypeAnyOf(InstructionTypes::LOAD, InstructionTypes::STORE))
+            {
+                // The data size of a vector access is its EEW (the index EEW if indexed)
+                const uint16_t eew = opinfo.getDataSize();
+                Rule & data = rules[opinfo.isInstType(InstructionTypes::LOAD) ? VD : VS3];
+                if (opinfo.isInstType(InstructionTypes::WHOLE))
+                {
+                    data = {Rule::FIXED_REGS, eew, static_cast<uint8_t>(nfields), 1};
+                    inst.ignores_vl = true;
+                    return false;
+                }
+                if (opinfo.isInstType(InstructionTypes::MASK))
+                {
+                    data.kind = Rule::MASK;
+                }
+                else if (opinfo.isInstTypeAnyOf(InstructionTypes::ORDERED_INDEXED,
+                                                InstructionTypes::UNORDERED_INDEXED))
+                {
+                    data.num_fields = nfields;
+                    rules[VS2].eew = eew;
+                }
+                else
+                {
+                    data.eew = eew;
+                    data.num_fields = nfields;
+                }
+                return true;
+            }
+
+            const std::string & mnemonic = opinfo.getMnemonic();
+            const size_t dot = mnemonic.find('.');
+            const std::string suffix = mnemonic.substr(mnemonic.rfind('.') + 1);
+
+            // vmv<nr>r.v
+            if (opinfo.isInstType(InstructionTypes::WHOLE))
+            {
+                const uint8_t nregs = mnemonic[dot - 2] - '0';
+                rules[VD] = rules[VS2] = {Rule::FIXED_REGS, sew, nregs, 1};
+                inst.ignores_vl = true;
+                return false;
+            }
+
+            if (opinfo.isInstType(InstructionTypes::WIDENING))
+            {
+                rules[VD].eew = 2 * sew;
+            }
+            if (suffix[0] == 'w') // vwadd.wv, vnsrl.wi, vfncvt.f.f.w, ...
+            {
+                rules[VS2].eew = 2 * sew;
+            }
+            if ((suffix == "vf2") || (suffix == "vf4") || (suffix == "vf8"))
+            {
+                rules[VS2].eew = sew / (suffix[2] - '0');
+            }
+            if (mnemonic == "vrgatherei16.vv")
+            {
+                rules[VS1].eew = 16;
+            }
+
+            if (suffix == "vs")
+            {
+                if (mnemonic.find("red") != std::string::npos)
+                {
+                    rules[VD].kind = rules[VS1].kind = Rule::SINGLE;
+                    rules[VS1].eew = rules[VD].eew;
+                }
+                else
+                {
+                    rules[VS2].kind = Rule::SINGLE; // Vector crypto element group
+                }
+            }
+            else if (suffix == "s") // vmv.x.s, vfmv.f.s
+            {
+                rules[VS2].kind = Rule::SINGLE;
+            }
+            else if (mnemonic.find(".s.") != std::string::npos) // vmv.s.x, vfmv.s.f
+            {
+                rules[VD].kind = Rule::SINGLE;
+            }
+
+            if (suffix == "mm")
+            {
+                rules[VD].kind = rules[VS1].kind = rules[VS2].kind = Rule::MASK;
+            }
+            else if (suffix == "m") // vmsbf.m, viota.m, vcpop.m, ...
+            {
+                rules[VS2].kind = Rule::MASK;
+            }
+            else if (suffix == "vm") // vcompress.vm
+            {
+                rules[VS1].kind = Rule::MASK;
+            }
+            if (opinfo.isInstType(InstructionTypes::MASK))
+            {
+                rules[VD].kind = Rule::MASK;
+            }
+            return true;
+        }
+
+        // Fill in an operand (once) and return its register mask
+        uint32_t resolve_(const OperandIndex idx, const uint32_t base, const Rule & rule)
+        {
+            Operand & op = operands[idx];
+            if (op.isValid())
+            {
+                return op.mask;
+            }
+            op.base = base;
+            op.num_fields = rule.num_fields;
+            op.regs_per_field = 1;
+            op.eew = rule.eew;
+            switch (rule.kind)
+            {
+                case Rule::MASK:
+                    op.eew = 1;
+                    break;
+                case Rule::SINGLE:
+                    break;
+                case Rule::FIXED_REGS:
+                    op.regs_per_field = rule.num_regs;
+                    op.emul_log2 = log2_(rule.num_regs);
+                    break;
+                case Rule::GROUP:
+                    if ((op.eew < 8) || (op.eew > 64))
+                    {
+                        setStatus_(Status::ILLEGAL_EEW);
+                        return 0;
+                    }
+                    op.emul_log2 = vtype.lmul_log2 + log2_(op.eew) - log2_(vtype.sew);
+                    if ((op.emul_log2 < -3) || (op.emul_log2 > 3))
+                    {
+                        setStatus_(Status::ILLEGAL_EEW);
+                        return 0;
+                    }
+                    op.regs_per_field = (op.emul_log2 > 0) ? (1u << op.emul_log2) : 1;
+                    break;
+            }
+            if (op.getNumRegs() > MAX_GROUP_REGS)
+            {
+                setStatus_(Status::ILLEGAL_EEW);
+                return 0;
+            }
+            if (((base % op.regs_per_field) != 0) || ((base + op.getNumRegs()) > NUM_VREGS))
+            {
+                setStatus_(Status::MISALIGNED_GROUP);
+                return 0;
+            }
+            op.mask = groupMask_(base, op.getNumRegs());
+            return op.mask;
+        }
+
+        void setStatus_(const Status s)
+        {
+            if (status == Status::OK)
+            {
+                status = s;
+            }
+        }
+    };
+
+} // namespace mavis
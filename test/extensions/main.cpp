@@ -2,11 +2,16 @@
 #include "mavis/ExtensionManager.hpp"
 #define ENABLE_GRAPH_SANITY_CHECKER
 #include "mavis/extension_managers/RISCVExtensionManager.hpp"
+#include "mavis/StaticDecoderCheck.hpp"
+#include "mavis/DecodeImageReplicas.hpp"
 
 #include "Inst.h"
 #include "uArchInfo.h"
 
 #include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
 #include <cstdlib> // for std::abort
 
 #define ASSERT_ALWAYS(condition) \
@@ -287,6 +292,279 @@ int main(int argc, char* argv[])
 
         iptr = mavis.makeInstFromTrace(addi, 0);
         iptr = mavis.makeInstFromTrace(fadd, 0);
+
+        // Trace overrides are built once per (mnemonic, opcode) and don't disturb normal decode
+        const ExampleTraceInfo custom{"custom.op", addi.getOpcode()};
+        iptr = mavis.makeInstFromTrace(custom, 0);
+        ASSERT_ALWAYS(iptr->getMnemonic() == "custom.op");
+        Instruction<uArchInfo>::PtrType iptr2 = mavis.makeInstFromTrace(custom, 0);
+        ASSERT_ALWAYS(iptr->getOpInfo() == iptr2->getOpInfo());
+        ASSERT_ALWAYS(mavis.makeInstFromTrace(addi, 0)->getMnemonic() == "addi");
+
+        // Borrowed decode info stays put until the caches are flushed
+        const auto & info_ref = mavis.getInfoRef(addi.getOpcode());
+        ASSERT_ALWAYS(&mavis.getInfoRef(addi.getOpcode()) == &info_ref);
+        ASSERT_ALWAYS(info_ref.opinfo->getMnemonic() == "addi");
+        ASSERT_ALWAYS(mavis.isOpcodeInstType(addi.getOpcode(),
+                                             mavis::InstMetaData::InstructionTypes::INT));
+        // Classification (jalr x0, 0(x1) is a return)
+        ASSERT_ALWAYS(
+            mavis.isOpcodeInstType(0x00008067, mavis::InstMetaData::InstructionTypes::JALR));
+        ASSERT_ALWAYS(mavis.isOpcodeExtractedInstType(
+            0x00008067, mavis::OpcodeInfo::ExtractedInstTypes::RETURN));
+        ASSERT_ALWAYS(!mavis.isOpcodeExtractedInstType(
+            0x00008067, mavis::OpcodeInfo::ExtractedInstTypes::CALL));
+        // Every bit of the queried type must be set (so NONE always matches)
+        ASSERT_ALWAYS(mavis.isOpcodeExtractedInstType(
+            0x00008067, mavis::OpcodeInfo::ExtractedInstTypes::NONE));
+        ASSERT_ALWAYS((mavis.getOpcodeInstTypes(addi.getOpcode())
+                       & static_cast<uint64_t>(mavis::InstMetaData::InstructionTypes::BRANCH))
+                      == 0);
+        mavis.flushCaches();
+        ASSERT_ALWAYS(mavis.getInfoRef(addi.getOpcode()).opinfo->getMnemonic() == "addi");
+
+        // A classification miss resolves the type bits without decoding, and agrees with a
+        // decode (jal ra; jalr ra, 0(a0); the mv overlay of addi; c.jr ra)
+        for (const uint64_t icode : {0x008000efull, 0x000500e7ull, 0x00058513ull, 0x8082ull})
+        {
+            const auto types = mavis.getOpcodeInstTypes(icode);
+            const auto opinfo = mavis.makeInst(icode, 0)->getOpInfo();
+            ASSERT_ALWAYS(types == opinfo->getInstType());
+            for (const auto itype : {mavis::OpcodeInfo::ExtractedInstTypes::CALL,
+                                     mavis::OpcodeInfo::ExtractedInstTypes::RETURN,
+                                     mavis::OpcodeInfo::ExtractedInstTypes::INDIRECT})
+            {
+                ASSERT_ALWAYS(mavis.isOpcodeExtractedInstType(icode, itype)
+                              == opinfo->isExtractedInstType(itype));
+            }
+        }
+        ASSERT_ALWAYS(
+            mavis.isOpcodeInstType(0x00058513, mavis::InstMetaData::InstructionTypes::MOVE));
+    }
+
+    {
+        // Test direct instruction creation and morphing by UID
+        auto man = mavis::extension_manager::riscv::RISCVExtensionManager::fromISA(
+            "rv64gc_zicsr_zifencei", "json/riscv_isa_spec.json", "json");
+        auto mavis = man.constructMavis<Instruction<uArchInfo>, uArchInfo>(
+            {"uarch/uarch_rv64g.json"});
+
+        const mavis::InstructionUniqueID add_uid = mavis.lookupInstructionUniqueID("add");
+        const mavis::InstructionUniqueID sub_uid = mavis.lookupInstructionUniqueID("sub");
+        ASSERT_ALWAYS(add_uid != mavis::INVALID_UID);
+        ASSERT_ALWAYS(sub_uid != mavis::INVALID_UID);
+
+        Instruction<uArchInfo>::PtrType iptr =
+            mavis.makeInstDirectly(mavis::ExtractorDirectInfo(add_uid, {1, 2}, {3}), 0);
+        ASSERT_ALWAYS(iptr->getMnemonic() == "add");
+        ASSERT_ALWAYS(iptr->getUID() == add_uid);
+
+        mavis.morphInst(iptr, mavis::ExtractorDirectInfo(sub_uid, {1, 2}, {3}));
+        ASSERT_ALWAYS(iptr->getMnemonic() == "sub");
+        ASSERT_ALWAYS(iptr->getUID() == sub_uid);
+
+        testException<mavis::UnknownMnemonic>(
+            [&mavis]()
+            { mavis.makeInstDirectly(mavis::ExtractorDirectInfo("notaninst", {}, {}), 0); });
+
+        // Prepared direct handles
+        const auto add_handle = mavis.prepareDirect(add_uid);
+        ASSERT_ALWAYS(add_handle.isValid());
+        ASSERT_ALWAYS(add_handle.getMnemonic() == "add");
+        ASSERT_ALWAYS(mavis.prepareDirect("sub").getUID() == sub_uid);
+
+        iptr = mavis.makeInstDirectly(add_handle, mavis::ExtractorDirectInfo("", {4, 5}, {6}), 0);
+        ASSERT_ALWAYS(iptr->getMnemonic() == "add");
+        ASSERT_ALWAYS(iptr->getUID() == add_uid);
+        ASSERT_ALWAYS(iptr->getOpInfo()->getSourceRegs() == ((1ull << 4) | (1ull << 5)));
+        ASSERT_ALWAYS(iptr->getOpInfo()->getDestRegs() == (1ull << 6));
+        Instruction<uArchInfo>::PtrType iptr2 =
+            mavis.makeInstDirectly(add_handle, mavis::ExtractorDirectInfo("", {4, 5}, {6}), 0);
+        ASSERT_ALWAYS(iptr->getOpInfo() == iptr2->getOpInfo());
+
+        mavis.morphInst(iptr, mavis.prepareDirect(sub_uid),
+                        mavis::ExtractorDirectInfo("", {1, 2}, {3}));
+        ASSERT_ALWAYS(iptr->getMnemonic() == "sub");
+
+        // Morphs with identical operands share the memoized OpcodeInfo
+        iptr2 = mavis.makeInstDirectly(mavis::ExtractorDirectInfo(add_uid, {1, 2}, {3}), 0);
+        mavis.morphInst(iptr2, mavis::ExtractorDirectInfo(sub_uid, {1, 2}, {3}));
+        mavis.morphInst(iptr, mavis::ExtractorDirectInfo(sub_uid, {1, 2}, {3}));
+        ASSERT_ALWAYS(iptr->getOpInfo() == iptr2->getOpInfo());
+        mavis.morphInst(iptr2, mavis::ExtractorDirectInfo("sub", {1, 2}, {4}));
+        ASSERT_ALWAYS(iptr->getOpInfo() != iptr2->getOpInfo());
+        ASSERT_ALWAYS(iptr2->getOpInfo()->getDestRegs() == (1ull << 4));
+
+        testException<mavis::UnknownMnemonic>([&mavis]() { mavis.prepareDirect("notaninst"); });
+        const decltype(add_handle) invalid_handle;
+        ASSERT_ALWAYS(!invalid_handle.isValid());
+        testException<mavis::UnknownMnemonic>(
+            [&mavis, &invalid_handle]()
+            {
+                mavis.makeInstDirectly(invalid_handle, mavis::ExtractorDirectInfo("", {1}, {2}),
+                                       0);
+            });
+
+        // Decode into preallocated instruction slots
+        const std::vector<mavis::Opcode> icodes{0x00c58533,  // add x10,x11,x12
+                                                0x40c58533}; // sub x10,x11,x12
+        std::vector<Instruction<uArchInfo>> slots(icodes.size(), *iptr);
+        mavis.decodeInto(icodes, slots);
+        ASSERT_ALWAYS(slots[0].getUID() == add_uid);
+        ASSERT_ALWAYS(slots[1].getUID() == sub_uid);
+        mavis.decodeInto(icodes[1], slots[0]);
+        ASSERT_ALWAYS(slots[0].getMnemonic() == "sub");
+        ASSERT_ALWAYS(slots[0].getOpInfo()->getDestRegs() == (1ull << 10));
+        testException<std::invalid_argument>(
+            [&mavis, &icodes, &slots]()
+            { mavis.decodeInto(icodes, std::span<Instruction<uArchInfo>>(slots).first(1)); });
+
+        // Per-hart decode views switch contexts without touching the facade or each other
+        mavis.makeContext("RV64I", {"json/isa_rv64i.json"}, {"uarch/uarch_rv64g.json"});
+        auto hart0 = mavis.makeDecodeView("BASE");
+        auto hart1 = mavis.makeDecodeView("RV64I");
+        ASSERT_ALWAYS(hart0.getInfo(0x0001)->opinfo->getMnemonic() == "c.nop");
+        testException<mavis::UnknownOpcode>([&hart1]() { hart1.getInfo(0x0001); });
+        ASSERT_ALWAYS(hart1.getInfo(icodes[0])->opinfo->getMnemonic() == "add");
+        hart1.switchContext(mavis.getContextRegistry().getContext("BASE"));
+        ASSERT_ALWAYS(hart1.isOpcodeInstType(0x0001, mavis::InstMetaData::InstructionTypes::INT));
+        ASSERT_ALWAYS(!hart1.isOpcodeInstType(
+            0x0001, static_cast<mavis::InstMetaData::InstructionTypes>(
+                        static_cast<uint64_t>(mavis::InstMetaData::InstructionTypes::INT)
+                        | static_cast<uint64_t>(mavis::InstMetaData::InstructionTypes::BRANCH))));
+        hart0.switchContext("RV64I");
+        testException<mavis::UnknownOpcode>([&hart0]() { hart0.getInfo(0x0001); });
+        ASSERT_ALWAYS(mavis.getInfo(0x0001)->opinfo->getMnemonic() == "c.nop");
+        testException<mavis::UnknownContext>([&hart0]() { hart0.switchContext("NOPE"); });
+
+        // UID-indexed handler dispatch: mnemonic beats tag beats default
+        mavis::DispatchTable<int (*)(int)> exec;
+        exec.setDefault([](int) { return -1; });
+        exec.registerMnemonic("add", [](int x) { return x + 1; });
+        exec.registerTag("f", [](int x) { return x * 2; });
+        exec.resolve(mavis);
+        ASSERT_ALWAYS(exec[add_uid](1) == 2);
+        ASSERT_ALWAYS(exec.at(*mavis.getInfo(0x00b57553)->opinfo)(3) == 6); // fadd.s
+        ASSERT_ALWAYS(exec.at(*mavis.getInfo(0x952e)->opinfo)(1) == 2);     // c.add
+        ASSERT_ALWAYS(exec[sub_uid](1) == -1);
+        // Overlays have their own UIDs and fall back to the instruction they overlay
+        const auto & nop_opinfo = *mavis.getInfo(0x00000013)->opinfo;
+        const auto & mv_opinfo = *mavis.getInfo(0x00058513)->opinfo; // mv a0, a1
+        ASSERT_ALWAYS((nop_opinfo.getMnemonic() == "nop") && (mv_opinfo.getMnemonic() == "mv"));
+        ASSERT_ALWAYS(nop_opinfo.getInstructionUniqueID() != mavis.lookupInstructionUniqueID("li"));
+        ASSERT_ALWAYS(exec.at(nop_opinfo)(1) == -1);
+        exec.registerMnemonic("li", [](int x) { return x + 2; });
+        exec.registerMnemonic("addi", [](int x) { return x + 3; });
+        exec.resolve(mavis);
+        ASSERT_ALWAYS(exec.at(nop_opinfo)(1) == 3);
+        ASSERT_ALWAYS(exec.at(mv_opinfo)(1) == 4);
+        exec.registerMnemonic("nop", [](int x) { return x; });
+        exec.resolve(mavis);
+        ASSERT_ALWAYS(exec.at(nop_opinfo)(1) == 1);
+        exec.registerMnemonic("not-an-instruction", [](int x) { return x; });
+        testException<mavis::UnknownMnemonic>([&exec, &mavis]() { exec.resolve(mavis); });
+
+        // Compact decode
+        const mavis::CompactInst add_compact = mavis.decodeCompact(icodes[0]);
+        ASSERT_ALWAYS(add_compact.uid == add_uid);
+        ASSERT_ALWAYS((add_compact.getRd() == 10) && (add_compact.getRs1() == 11)
+                      && (add_compact.getRs2() == 12)
+                      && (add_compact.getRs3() == mavis::CompactInst::NO_REG));
+        ASSERT_ALWAYS(add_compact.getOperandType(mavis::CompactInst::RS1_IDX)
+                      == mavis::InstMetaData::OperandTypes::LONG);
+        ASSERT_ALWAYS(add_compact.isInstType(mavis::InstMetaData::InstructionTypes::INT));
+        ASSERT_ALWAYS((add_compact.size == 4)
+                      && !add_compact.hasFlag(mavis::CompactInst::HAS_IMMEDIATE));
+        const mavis::CompactInst addi_compact = mavis.decodeCompact(0xfff10093); // addi x1,x2,-1
+        ASSERT_ALWAYS(addi_compact.hasFlag(mavis::CompactInst::SIGNED_IMMEDIATE));
+        ASSERT_ALWAYS(addi_compact.getSignedImmediate() == -1);
+        ASSERT_ALWAYS(mavis.decodeCompact(0x0001).size == 2); // c.nop
+        testException<mavis::UnknownOpcode>([&mavis]() { mavis.decodeCompact(0x0000000b); });
+
+        // Optimizing the decode trie leaves decode results alone
+        const std::vector<mavis::Opcode> trie_icodes{0x00c58533, 0x40c58533, 0xfff10093,
+                                                     0x00008067, 0x0001,     0x4501};
+        std::vector<std::string> mnemonics;
+        for (const auto icode : trie_icodes)
+        {
+            mnemonics.emplace_back(mavis.getInfo(icode)->opinfo->getMnemonic());
+        }
+        const auto [before, after] = mavis.optimizeDecodeTrie();
+        ASSERT_ALWAYS((after.num_nodes < before.num_nodes) && (after.num_match > 0));
+        ASSERT_ALWAYS(after.num_leaves == before.num_leaves);
+        mavis.flushCaches();
+        for (uint32_t i = 0; i < trie_icodes.size(); ++i)
+        {
+            ASSERT_ALWAYS(mavis.getInfo(trie_icodes[i])->opinfo->getMnemonic() == mnemonics[i]);
+        }
+        testException<mavis::UnknownOpcode>([&mavis]() { mavis.getInfo(0x0000000b); });
+
+        // Decode profile round trip and cache pre-warm (undecodable opcodes are skipped)
+        mavis::DecodeProfile profile;
+        for (uint32_t i = 0; i < trie_icodes.size(); ++i)
+        {
+            profile.record(trie_icodes[i], i + 1);
+        }
+        profile.record(0x0000000b, 100);
+        std::stringstream profile_file;
+        profile.save(profile_file);
+        mavis::DecodeProfile loaded;
+        loaded.load(profile_file);
+        ASSERT_ALWAYS((loaded.size() == 7) && (loaded.getCount(0x4501) == 6));
+        ASSERT_ALWAYS(loaded.getHottest(2)[1].first == 0x4501);
+        mavis.flushCaches();
+        ASSERT_ALWAYS(mavis.applyDecodeProfile(loaded) == trie_icodes.size());
+        ASSERT_ALWAYS(mavis.decodeCompact(0x4501).uid
+                      == mavis.getInfo(0x4501)->opinfo->getInstructionUniqueID());
+        std::stringstream bad_profile("0x13 1\nnot-a-profile\n");
+        testException<mavis::BadDecodeProfile>([&bad_profile]()
+                                               { mavis::DecodeProfile().load(bad_profile); });
+
+        // Pointer-free decode image, mapped from a file, agrees with the dynamic decoder
+        {
+            std::ofstream image_file("decode_image.bin", std::ios::binary);
+            mavis.writeDecodeImage(image_file, "rv64gc_zicsr_zifencei");
+        }
+        const mavis::DecodeImage image = mavis::DecodeImage::map("decode_image.bin");
+        std::remove("decode_image.bin");
+        ASSERT_ALWAYS(image.getDescription() == "rv64gc_zicsr_zifencei");
+        ASSERT_ALWAYS(image.getMnemonic(image.decode(0x00c58533)) == "add");
+        ASSERT_ALWAYS(image.decode(0x0000) == mavis::DecodeImage::ILLEGAL);
+        ASSERT_ALWAYS(image.decode(0x0000000b) == mavis::DecodeImage::UNKNOWN);
+        ASSERT_ALWAYS(mavis::checkDecodeImage(mavis, image, 1u << 16).empty());
+        const mavis::DecodeImageReplicas replicas(image);
+        ASSERT_ALWAYS(replicas.getNumReplicas() == replicas.getTopology().getNumNodes());
+        ASSERT_ALWAYS((replicas.getNumReplicas() > 1) || replicas.allPlaced());
+        ASSERT_ALWAYS(replicas.local().decode(0x00c58533) == image.decode(0x00c58533));
+        ASSERT_ALWAYS(mavis::NumaTopology::parseCpuList("0-3,8,10-11\n").size() == 7);
+        std::stringstream truncated(std::string("MVDI"));
+        testException<mavis::BadDecodeImage>([&truncated]()
+                                             { mavis::DecodeImage::read(truncated); });
+
+        // A node referring back to itself (a cycle) is rejected rather than looping in decode()
+        std::stringstream image_stream;
+        mavis.writeDecodeImage(image_stream, "rv64gc_zicsr_zifencei");
+        const std::string image_bytes = image_stream.str();
+        std::vector<uint32_t> cyclic(image_bytes.size() / sizeof(uint32_t));
+        std::memcpy(cyclic.data(), image_bytes.data(), image_bytes.size());
+        const uint32_t root = cyclic[mavis::DecodeImage::H_ROOT];
+        // Default reference of the root node (see DecodeImage::NodeKind)
+        cyclic[root + ((cyclic[root] == mavis::DecodeImage::CASES) ? 1
+                       : (cyclic[root] == mavis::DecodeImage::SWITCH) ? 2
+                                                                      : 3)] = root;
+        testException<mavis::BadDecodeImage>([&cyclic]()
+                                             { mavis::DecodeImage::fromWords(cyclic); });
+    }
+
+    {
+        // Test MaskMatchTable keeps first-match priority across masks
+        mavis::MaskMatchTable table;
+        table.build({{0xff, 0x13}, {0xf, 0x3}, {0xff, 0x03}, {0xf, 0x13}});
+        ASSERT_ALWAYS(table.getNumPartitions() == 2);
+        ASSERT_ALWAYS(table.find(0x113) == 0);
+        ASSERT_ALWAYS(table.find(0x103) == 1);
+        ASSERT_ALWAYS(table.find(0x123) == 1);
+        ASSERT_ALWAYS(table.find(0x104) == mavis::MaskMatchTable::NO_MATCH);
     }
 
     {
@@ -343,5 +621,160 @@ int main(int argc, char* argv[])
             ASSERT_ALWAYS(enabled_extensions.isEnabled("zalrsc"));
         }
     }
+
+    {
+        // Vector register groups resolved against vtype
+        auto man = mavis::extension_manager::riscv::RISCVExtensionManager::fromISA(
+            "rv64gcv_zicsr_zifencei", "json/riscv_isa_spec.json", "json");
+        auto mavis = man.constructMavis<Instruction<uArchInfo>, uArchInfo>(
+            {"uarch/uarch_rv64g.json"});
+        using mavis::VectorInst;
+        constexpr uint64_t e32m2 = 0x11, e8m4 = 0x02, e32m8 = 0x13, vill = 1ull << 63;
+
+        const VectorInst vadd = mavis.decodeVector(0x02c40257, e32m2); // vadd.vv v4,v8,v12
+        ASSERT_ALWAYS(vadd.isLegal() && vadd.vector && !vadd.uses_v0);
+        ASSERT_ALWAYS((vadd.dest_mask == 0x30) && (vadd.src_mask == 0x3300));
+        ASSERT_ALWAYS(vadd.getBodyMask(VectorInst::VD, 4, 128) == 0x10);
+        ASSERT_ALWAYS(vadd.preservesVd()); // Tail undisturbed
+        ASSERT_ALWAYS(mavis.decodeVector(0x00c40257, e32m2).src_mask == 0x3301); // v0.t
+        ASSERT_ALWAYS(mavis.decodeVector(0x02c402d7, e32m2).status
+                      == VectorInst::Status::MISALIGNED_GROUP); // vd = v5
+        ASSERT_ALWAYS(mavis.decodeVector(0x02c40257, vill).status
+                      == VectorInst::Status::ILLEGAL_VTYPE);
+
+        const VectorInst vwadd = mavis.decodeVector(0xc6c42257, e32m2); // vwadd.vv
+        ASSERT_ALWAYS((vwadd.dest_mask == 0xf0) && (vwadd.getOperand(VectorInst::VD).eew == 64));
+        const VectorInst vnsrl = mavis.decodeVector(0xb2c40257, e32m2); // vnsrl.wv
+        ASSERT_ALWAYS((vnsrl.dest_mask == 0x30) && (vnsrl.src_mask == 0xf300));
+        const VectorInst vmseq = mavis.decodeVector(0x62c40257, e32m2);
+        ASSERT_ALWAYS((vmseq.dest_mask == 0x10) && (vmseq.getOperand(VectorInst::VD).eew == 1));
+        const VectorInst vredsum = mavis.decodeVector(0x02c42257, e32m2);
+        ASSERT_ALWAYS((vredsum.dest_mask == 0x10) && (vredsum.src_mask == 0x3100));
+
+        // vlseg2e16.v v4: 2 fields of EMUL 16/32*2 = 1, then of EMUL 4, then too big
+        ASSERT_ALWAYS(mavis.decodeVector(0x22055207, e32m2).dest_mask == 0x30);
+        ASSERT_ALWAYS(mavis.decodeVector(0x22055207, e32m8).dest_mask == 0xff0);
+        ASSERT_ALWAYS(mavis.decodeVector(0x22055207, e8m4).status
+                      == VectorInst::Status::ILLEGAL_EEW);
+        // Whole register loads do not depend on vtype (or vl)
+        const VectorInst vl2re8 = mavis.decodeVector(0x22850207, vill);
+        ASSERT_ALWAYS(vl2re8.isLegal() && (vl2re8.dest_mask == 0x30));
+        ASSERT_ALWAYS(vl2re8.getBodyMask(VectorInst::VD, 0, 128) == 0x30);
+
+        ASSERT_ALWAYS(!mavis.decodeVector(0x00c58533, e32m2).vector); // add
+        // Results are copies: later decodes (and flushes) leave the earlier ones alone
+        mavis.flushCaches();
+        ASSERT_ALWAYS((vadd.dest_mask == 0x30) && (vwadd.dest_mask == 0xf0));
+
+        // Dependencies within a window of instructions
+        using DepType = mavis::DependencyWindow::DepType;
+        std::vector<Instruction<uArchInfo>::PtrType> window;
+        for (const mavis::Opcode icode : {0x00c58533,  // add x10,x11,x12
+                                          0x40c505b3,  // sub x11,x10,x12
+                                          0x00a58533,  // add x10,x11,x10
+                                          0x00b57553,  // fadd.s f10,f10,f11
+                                          0x00150013}) // addi x0,x10,1
+        {
+            window.emplace_back(mavis.makeInst(icode, 0));
+        }
+        mavis::DependencyWindow deps;
+        deps.analyzeInsts(window);
+        ASSERT_ALWAYS(deps.size() == 5);
+        ASSERT_ALWAYS(deps.dependsOn(1, 0, DepType::RAW) && deps.dependsOn(1, 0, DepType::WAR));
+        ASSERT_ALWAYS((deps.getDeps(DepType::RAW, 2)[0] == 0b11)
+                      && (deps.getDeps(DepType::WAW, 2)[0] == 0b01)
+                      && (deps.getDeps(DepType::WAR, 2)[0] == 0b10));
+        ASSERT_ALWAYS(!deps.dependsOn(3, 2) && !deps.dependsOn(3, 0)); // f10 is not x10
+        ASSERT_ALWAYS((deps.getDeps(DepType::RAW, 4)[0] == 0b100)
+                      && (deps.getDeps(DepType::WAW, 4)[0] == 0)); // x0
+        const auto producers = deps.getProducers(2);
+        ASSERT_ALWAYS((producers.size() == 2) && (producers[0].reg == 10)
+                      && (producers[0].producer == 0) && (producers[1].producer == 1));
+        ASSERT_ALWAYS(deps.getProducers(0)[0].producer == mavis::DependencyWindow::NO_PRODUCER);
+
+        // Full register groups: vwadd.vv v4,v12,v8 (e32m2) writes v4-v7 and reads v8-v9, so
+        // vadd.vv v8,v12,v6 depends on it both ways
+        std::vector<mavis::RegisterMasks> vmasks;
+        for (const mavis::Opcode icode : {0xc6c42257u, 0x02c30457u})
+        {
+            vmasks.emplace_back(mavis::RegisterMasks::build(*mavis.getInfo(icode)->opinfo));
+            vmasks.back().setVector(mavis.decodeVector(icode, e32m2));
+        }
+        deps.analyze(vmasks);
+        ASSERT_ALWAYS(deps.dependsOn(1, 0, DepType::RAW) && deps.dependsOn(1, 0, DepType::WAR));
+    }
+
+    {
+        // Register lists are held in place until they outgrow the inline capacity
+        mavis::ExtractorIF::RegListType regs{1, 2, 3};
+        ASSERT_ALWAYS(regs.isInline());
+        for (uint32_t reg = 4; reg < 20; ++reg)
+        {
+            regs.push_back(reg);
+        }
+        ASSERT_ALWAYS(!regs.isInline());
+        ASSERT_ALWAYS((regs.size() == 19) && (regs.front() == 1) && (regs.back() == 19));
+        const mavis::ExtractorIF::RegListType regs_copy = regs;
+        ASSERT_ALWAYS(regs_copy == regs);
+    }
+
+    {
+        // Special fields maps behave like std::map: lookups, ordered iteration by reference
+        using SpecialField = mavis::InstMetaData::SpecialField;
+        const mavis::InstMetaData::SpecialFieldsMap sfields{{SpecialField::VM, 1},
+                                                            {SpecialField::CSR, 0x300},
+                                                            {SpecialField::NF, 3}};
+        ASSERT_ALWAYS(sfields.find(SpecialField::CSR)->second == 0x300);
+        ASSERT_ALWAYS((*sfields.find(SpecialField::NF)).first == SpecialField::NF);
+        ASSERT_ALWAYS(sfields.find(SpecialField::RM) == sfields.end());
+        ASSERT_ALWAYS(sfields.contains(SpecialField::VM) && !sfields.contains(SpecialField::AQ));
+        ASSERT_ALWAYS((sfields.at(SpecialField::VM) == 1)
+                      && (sfields.count(SpecialField::RL) == 0));
+        testException<std::out_of_range>([&sfields]() { sfields.at(SpecialField::RM); });
+
+        std::vector<std::pair<SpecialField, uint32_t>> visited;
+        for (const auto & [field, value] : sfields)
+        {
+            visited.emplace_back(field, value);
+        }
+        const std::vector<std::pair<SpecialField, uint32_t>> expected{
+            {SpecialField::CSR, 0x300}, {SpecialField::NF, 3}, {SpecialField::VM, 1}};
+        ASSERT_ALWAYS(visited == expected);
+    }
+
+    {
+        // Form field layouts and immediate swizzling are evaluated at compile time
+        using mavis::Form_R;
+        constexpr uint64_t add_x10_x11_x12 = 0x00c58533;
+        static_assert(Form_R::field_layout[Form_R::idType::RD].extract(add_x10_x11_x12) == 10);
+        static_assert(Form_R::field_layout[Form_R::idType::RS2].extract(add_x10_x11_x12) == 12);
+        static_assert(mavis::Swizzler::extract(0b10, mavis::Swizzler::Range{1},
+                                               mavis::Swizzler::Range{0})
+                      == 0b01);
+        // The runtime field list is built from the same layout
+        ASSERT_ALWAYS(Form_R::fields[Form_R::idType::RS1].getShiftedMask()
+                      == Form_R::field_layout[Form_R::idType::RS1].getShiftedMask());
+    }
+
+    {
+        // Decoder handles count references the same way under either refcount policy
+        struct Counted : public mavis::RefCounted
+        {
+            explicit Counted(uint32_t v) : value(v) {}
+
+            uint32_t value;
+        };
+
+        mavis::SharedPtr<Counted> first = mavis::makeShared<Counted>(7);
+        mavis::SharedPtr<Counted> second = first;
+        ASSERT_ALWAYS((first.use_count() == 2) && (second->value == 7));
+        const mavis::SharedPtr<Counted> moved = std::move(second);
+        ASSERT_ALWAYS((second == nullptr) && (first.use_count() == 2));
+        // A copy of the object starts with its own count
+        const mavis::SharedPtr<Counted> copy = mavis::makeShared<Counted>(*moved);
+        ASSERT_ALWAYS((copy.use_count() == 1) && (copy != moved));
+        first.reset();
+        ASSERT_ALWAYS(moved.use_count() == 1);
+    }
     return 0;
 }
@@ -0,0 +1,121 @@
+// Cross-node decode benchmark: decode the perf opcode set from a thread on each NUMA node, out of
+// a single decode image placed on node 0 ("shared") and out of that node's replica ("replicated")
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mavis/Mavis.h"
+#include "mavis/DecodeImageReplicas.hpp"
+#include "mavis/extension_managers/RISCVExtensionManager.hpp"
+
+#include "Inst.h"
+#include "uArchInfo.h"
+
+using MavisType = Mavis<Instruction<uArchInfo>, uArchInfo>;
+
+namespace
+{
+    constexpr uint32_t NUM_PASSES = 100000;
+
+    // Nanoseconds per decode from a thread bound to node; nullopt if the thread cannot be bound
+    std::optional<double> timeDecodes(const mavis::NumaTopology & topology, const uint32_t node,
+                       const mavis::DecodeImage & image, const std::vector<uint32_t> & opcodes)
+    {
+        std::optional<double> ns_per_decode;
+        std::thread thread(
+            [&]()
+            {
+                if (!topology.bindCurrentThread(node))
+                {
+                    return;
+                }
+                uint64_t checksum = 0;
+                const auto start = std::chrono::steady_clock::now();
+                for (uint32_t pass = 0; pass < NUM_PASSES; ++pass)
+                {
+                    for (const uint32_t opcode : opcodes)
+                    {
+                        checksum += image.decode(opcode);
+                    }
+                }
+                const auto end = std::chrono::steady_clock::now();
+                if (checksum == 0)
+                {
+                    std::cerr << "Nothing decoded" << std::endl;
+                }
+                ns_per_decode = std::chrono::duration<double, std::nano>(end - start).count()
+                                / (double(NUM_PASSES) * opcodes.size());
+            });
+        thread.join();
+        return ns_per_decode;
+    }
+} // namespace
+
+int main()
+{
+    mavis::extension_manager::riscv::RISCVExtensionManager extension_manager =
+        mavis::extension_manager::riscv::RISCVExtensionManager::fromISA(
+            "rv64gcbvfdq_zicsr_zicbom", "json/riscv_isa_spec.json", "json");
+
+    std::unique_ptr<MavisType> mavis_facade = std::make_unique<MavisType>(
+        extension_manager.constructMavis<Instruction<uArchInfo>, uArchInfo>(
+            {"uarch/uarch_rv64g.json"}));
+
+    std::ifstream rv64_test("rv64.tset");
+    std::vector<uint32_t> opcodes;
+    std::string mnemonic, opcode;
+    while (rv64_test >> mnemonic >> opcode)
+    {
+        opcodes.emplace_back(std::stoul(opcode, 0, 16));
+    }
+    if (opcodes.empty()) [[unlikely]]
+    {
+        throw std::runtime_error("Expected at least 1 opcode");
+    }
+
+    const mavis::NumaTopology topology;
+    const mavis::DecodeImageReplicas replicas(mavis_facade->buildDecodeImage(), topology);
+    const mavis::DecodeImage & shared = replicas.forNode(0);
+
+    std::cout << "NUMA nodes: " << topology.getNumNodes()
+              << ", image size (bytes): " << shared.getSizeInBytes() << std::endl;
+    if (!replicas.allPlaced())
+    {
+        std::cout << "WARNING: some replicas could not be built on their node (see 'placed')"
+                  << std::endl;
+    }
+    // "unbound": no thread could be bound to the node, so there is nothing to measure
+    const auto format = [](const std::optional<double> & ns_per_decode)
+    {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(2);
+        if (ns_per_decode)
+        {
+            ss << *ns_per_decode;
+        }
+        else
+        {
+            ss << "unbound";
+        }
+        return ss.str();
+    };
+    std::cout << std::setw(6) << "node" << std::setw(8) << "placed" << std::setw(16)
+              << "shared ns/op" << std::setw(20) << "replicated ns/op" << std::endl;
+    for (uint32_t node = 0; node < topology.getNumNodes(); ++node)
+    {
+        std::cout << std::setw(6) << node << std::setw(8)
+                  << (replicas.isPlaced(node) ? "yes" : "no") << std::setw(16)
+                  << format(timeDecodes(topology, node, shared, opcodes)) << std::setw(20)
+                  << format(timeDecodes(topology, node, replicas.forNode(node), opcodes))
+                  << std::endl;
+    }
+    return 0;
+}
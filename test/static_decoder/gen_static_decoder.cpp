@@ -0,0 +1,53 @@
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mavis/Mavis.h"
+#include "mavis/extension_managers/RISCVExtensionManager.hpp"
+
+#include "Inst.h"
+#include "uArchInfo.h"
+
+using MavisType = Mavis<Instruction<uArchInfo>, uArchInfo>;
+
+int main(int argc, char** argv)
+{
+    namespace po = boost::program_options;
+    po::options_description desc(
+        "mavis_gen_static_decoder -- generate a standalone C++ decoder for a fixed ISA");
+    desc.add_options()("help,h", "Command line options")(
+        "isa,a", po::value<std::string>()->required(),
+        "ISA string (example: rv64gc_zicsr_zifencei)")(
+        "json-dir,j", po::value<std::string>()->default_value("json"),
+        "Directory holding riscv_isa_spec.json and the ISA JSON files")(
+        "uarch,u", po::value<std::vector<std::string>>()->required(), "uArch annotation file(s)")(
+        "class,c", po::value<std::string>()->required(), "Name of the generated struct")(
+        "output,o", po::value<std::string>()->required(), "Header file to write");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    if (vm.count("help"))
+    {
+        std::cout << desc << "\n";
+        return 0;
+    }
+    po::notify(vm);
+
+    const std::string isa = vm["isa"].as<std::string>();
+    const std::string json_dir = vm["json-dir"].as<std::string>();
+    const auto extension_manager = mavis::extension_manager::riscv::RISCVExtensionManager::fromISA(
+        isa, json_dir + "/riscv_isa_spec.json", json_dir);
+    MavisType mavis = extension_manager.constructMavis<Instruction<uArchInfo>, uArchInfo>(
+        vm["uarch"].as<std::vector<std::string>>());
+
+    std::ofstream os(vm["output"].as<std::string>());
+    if (!os)
+    {
+        std::cerr << "ERROR: cannot open " << vm["output"].as<std::string>() << std::endl;
+        return 1;
+    }
+    mavis.writeStaticDecoder(os, vm["class"].as<std::string>(), isa);
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Checks a decoder generated by mavis_gen_static_decoder, and a decode image of the same
+// configuration, against the dynamic decoder
+
+#include "mavis/Mavis.h"
+#include "mavis/StaticDecoderCheck.hpp"
+#include "mavis/extension_managers/RISCVExtensionManager.hpp"
+
+#include "Inst.h"
+#include "uArchInfo.h"
+
+#include "StaticDecoderRV64.hpp"
+
+#include <iostream>
+#include <cstdlib> // for std::abort
+
+#define ASSERT_ALWAYS(condition) \
+    if (!(condition)) { \
+        std::cerr << "Assertion failed: " << #condition << ", file " << __FILE__ \
+                  << ", line " << __LINE__ << std::endl; \
+        std::abort(); \
+    }
+
+using MavisType = Mavis<Instruction<uArchInfo>, uArchInfo>;
+
+int main()
+{
+    const auto extension_manager = mavis::extension_manager::riscv::RISCVExtensionManager::fromISA(
+        std::string(StaticDecoderRV64::DESCRIPTION), "json/riscv_isa_spec.json", "json");
+    MavisType mavis = extension_manager.constructMavis<Instruction<uArchInfo>, uArchInfo>(
+        {"uarch/uarch_rv64g.json"});
+
+    ASSERT_ALWAYS(StaticDecoderRV64::MNEMONICS[StaticDecoderRV64::decode(0x00c58533)] == "add");
+    ASSERT_ALWAYS(StaticDecoderRV64::MNEMONICS[StaticDecoderRV64::decode(0x00008067)] == "jalr");
+    ASSERT_ALWAYS(StaticDecoderRV64::decode(0x0000) == StaticDecoderRV64::ILLEGAL);
+    ASSERT_ALWAYS(StaticDecoderRV64::decode(0x0000000b) == StaticDecoderRV64::UNKNOWN);
+
+    // The decoder and its tables are usable at compile time
+    static_assert(StaticDecoderRV64::MNEMONICS[StaticDecoderRV64::decode(0x00c58533)] == "add");
+    constexpr auto add_operands = StaticDecoderRV64::OPERANDS[StaticDecoderRV64::decode(0x00c58533)];
+    static_assert(add_operands.complete && (add_operands.count == 3));
+    static_assert(StaticDecoderRV64::OPERAND_FIELDS[add_operands.first + add_operands.count - 1]
+                      .extract(0x00c58533)
+                  == 10); // rd
+    // c.jalr's link register is implied by the opcode
+    constexpr uint64_t c_jalr_x1 = 0x9082;
+    static_assert(StaticDecoderRV64::MNEMONICS[StaticDecoderRV64::decode(c_jalr_x1)] == "c.jalr");
+    ASSERT_ALWAYS(StaticDecoderRV64::OPERANDS[StaticDecoderRV64::decode(c_jalr_x1)].complete);
+
+    const auto uids = mavis::mapStaticDecoderUIDs<StaticDecoderRV64>(mavis);
+    ASSERT_ALWAYS(uids[StaticDecoderRV64::decode(0x00c58533)]
+                  == mavis.lookupInstructionUniqueID("add"));
+
+    const auto mismatches = mavis::checkStaticDecoder<StaticDecoderRV64>(mavis);
+    for (const auto & mismatch : mismatches)
+    {
+        std::cerr << "Static decoder drift: opcode 0x" << std::hex << mismatch.icode
+                  << " decodes to '" << mismatch.expected << "', generated decoder says '"
+                  << mismatch.actual << "'" << std::endl;
+    }
+    ASSERT_ALWAYS(mismatches.empty());
+
+    for (const auto & mismatch : mavis::checkStaticDecoderOperands<StaticDecoderRV64>(mavis))
+    {
+        std::cerr << "Static decoder operand drift: opcode 0x" << std::hex << mismatch.icode
+                  << ": '" << mismatch.expected << "', generated decoder says '"
+                  << mismatch.actual << "'" << std::endl;
+        std::abort();
+    }
+    ASSERT_ALWAYS(StaticDecoderRV64::ANNOTATIONS[StaticDecoderRV64::decode(0x00c58533)]
+                  != StaticDecoderRV64::NO_ANNOTATION);
+
+    // The decode image of the same configuration must agree too
+    const mavis::DecodeImage image =
+        mavis.buildDecodeImage(std::string(StaticDecoderRV64::DESCRIPTION));
+    for (const auto & mismatch : mavis::checkDecodeImage(mavis, image))
+    {
+        std::cerr << "Decode image drift: opcode 0x" << std::hex << mismatch.icode
+                  << " decodes to '" << mismatch.expected << "', image says '" << mismatch.actual
+                  << "'" << std::endl;
+        std::abort();
+    }
+    ASSERT_ALWAYS(image.getNumInsts() == StaticDecoderRV64::NUM_INSTS);
+
+    std::cout << "Static decoder (" << StaticDecoderRV64::DESCRIPTION << ", " << std::dec
+              << StaticDecoderRV64::NUM_INSTS << " instructions) and decode image (" << std::dec
+              << image.getSizeInBytes() << " bytes, " << image.getNumNodes() << " nodes) match"
+              << std::endl;
+    return 0;
+}